@@ -28,6 +28,10 @@ function(build_erf_lib erf_lib_name)
     target_compile_definitions(${erf_lib_name} PUBLIC ERF_USE_WARM_NO_PRECIP)
   endif()
 
+  if(ERF_ENABLE_SAT_TABLE)
+    target_compile_definitions(${erf_lib_name} PUBLIC ERF_USE_SAT_TABLE)
+  endif()
+
   if(ERF_ENABLE_POISSON_SOLVE)
     target_sources(${erf_lib_name} PRIVATE
                    ${SRC_DIR}/TimeIntegration/ERF_slow_rhs_inc.cpp
@@ -41,8 +45,11 @@ function(build_erf_lib erf_lib_name)
                    ${SRC_DIR}/Particles/ERFPCEvolve.cpp
                    ${SRC_DIR}/Particles/ERFPCInitializations.cpp
                    ${SRC_DIR}/Particles/ERFPCUtils.cpp
-                   ${SRC_DIR}/Particles/ERFTracers.cpp)
+                   ${SRC_DIR}/Particles/ERFTracers.cpp
+                   ${SRC_DIR}/Microphysics/SuperDroplets/SuperDroplets.cpp
+                   ${SRC_DIR}/Microphysics/SuperDroplets/SuperDropletPC.cpp)
     target_include_directories(${erf_lib_name} PUBLIC ${SRC_DIR}/Particles)
+    target_include_directories(${erf_lib_name} PUBLIC ${SRC_DIR}/Microphysics/SuperDroplets)
     target_compile_definitions(${erf_lib_name} PUBLIC ERF_USE_PARTICLES)
   endif()
 
@@ -177,19 +184,23 @@ function(build_erf_lib erf_lib_name)
        ${SRC_DIR}/Utils/TerrainMetrics.cpp
        ${SRC_DIR}/Utils/VelocityToMomentum.cpp
        ${SRC_DIR}/Utils/InteriorGhostCells.cpp
+       ${SRC_DIR}/Utils/Microphysics_Utils.cpp
        ${SRC_DIR}/Utils/Time_Avg_Vel.cpp
        ${SRC_DIR}/Microphysics/SAM/Init_SAM.cpp
        ${SRC_DIR}/Microphysics/SAM/Cloud_SAM.cpp
        ${SRC_DIR}/Microphysics/SAM/IceFall.cpp
        ${SRC_DIR}/Microphysics/SAM/Precip.cpp
        ${SRC_DIR}/Microphysics/SAM/PrecipFall.cpp
+       ${SRC_DIR}/Microphysics/SAM/Column_SAM.cpp
        ${SRC_DIR}/Microphysics/SAM/Update_SAM.cpp
        ${SRC_DIR}/Microphysics/Kessler/Init_Kessler.cpp
        ${SRC_DIR}/Microphysics/Kessler/Kessler.cpp
        ${SRC_DIR}/Microphysics/Kessler/Update_Kessler.cpp
+	   ${SRC_DIR}/WindFarmParametrization/WindFarmSources.cpp
 	   ${SRC_DIR}/WindFarmParametrization/Fitch/AdvanceFitch.cpp
 	   ${SRC_DIR}/WindFarmParametrization/EWP/AdvanceEWP.cpp
 	   ${SRC_DIR}/WindFarmParametrization/SimpleActuatorDisk/AdvanceSimpleAD.cpp
+	   ${SRC_DIR}/WindFarmParametrization/ActuatorLine/AdvanceActuatorLine.cpp
        ${SRC_DIR}/LandSurfaceModel/SLM/SLM.cpp
        ${SRC_DIR}/LandSurfaceModel/MM5/MM5.cpp
   )
@@ -242,6 +253,7 @@ function(build_erf_lib erf_lib_name)
   target_include_directories(${erf_lib_name} PUBLIC ${SRC_DIR}/WindFarmParametrization/Fitch)
   target_include_directories(${erf_lib_name} PUBLIC ${SRC_DIR}/WindFarmParametrization/EWP)
   target_include_directories(${erf_lib_name} PUBLIC ${SRC_DIR}/WindFarmParametrization/SimpleActuatorDisk)
+  target_include_directories(${erf_lib_name} PUBLIC ${SRC_DIR}/WindFarmParametrization/ActuatorLine)
   target_include_directories(${erf_lib_name} PUBLIC ${SRC_DIR}/LandSurfaceModel)
   target_include_directories(${erf_lib_name} PUBLIC ${SRC_DIR}/LandSurfaceModel/Null)
   target_include_directories(${erf_lib_name} PUBLIC ${SRC_DIR}/LandSurfaceModel/SLM)
@@ -126,6 +126,12 @@ ABLMost::update_fluxes (const int& lev,
 /**
  * Function to compute the fluxes (u^star and t^star) for Monin Obukhov similarity theory
  *
+ * With most.fixed_iters > 0 every surface cell starts from its u^star and Obukhov
+ * length of the previous step and takes the same number of iterations, so that
+ * neighboring cells do not diverge. The last change in u^star is checked once
+ * for the whole level afterwards; if it exceeds most.fixed_iters_tol, the level is
+ * iterated again to convergence from the log law as when fixed_iters = 0.
+ *
  * @param[in] lev Current level
  * @param[in] max_iters maximum iterations to use
  * @param[in] most_flux structure to iteratively compute ustar and tstar
@@ -141,40 +147,70 @@ ABLMost::compute_fluxes (const int& lev,
     const auto *const tm_ptr  = m_ma.get_average(lev,2);
     const auto *const umm_ptr = m_ma.get_average(lev,4);
 
-    for (MFIter mfi(*u_star[lev]); mfi.isValid(); ++mfi)
+    // Iterate every surface cell, to convergence from the log law if fixed_iters is 0;
+    // with fixed_iters > 0, returns the largest change in u^star over the last iteration
+    auto iterate = [&] (int fixed_iters) -> Real
     {
-        Box gtbx = mfi.growntilebox();
+        ReduceOps<ReduceOpMax> reduce_op;
+        ReduceData<Real> reduce_data(reduce_op);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
 
-        auto u_star_arr = u_star[lev]->array(mfi);
-        auto t_star_arr = t_star[lev]->array(mfi);
-        auto t_surf_arr = t_surf[lev]->array(mfi);
-        auto olen_arr   = olen[lev]->array(mfi);
+        for (MFIter mfi(*u_star[lev]); mfi.isValid(); ++mfi)
+        {
+            Box gtbx = mfi.growntilebox();
+
+            auto u_star_arr = u_star[lev]->array(mfi);
+            auto t_star_arr = t_star[lev]->array(mfi);
+            auto t_surf_arr = t_surf[lev]->array(mfi);
+            auto olen_arr   = olen[lev]->array(mfi);
+
+            const auto tm_arr  = tm_ptr->array(mfi);
+            const auto umm_arr = umm_ptr->array(mfi);
+            const auto z0_arr  = z_0[lev].array();
+
+            // Wave properties if they exist
+            const auto Hwave_arr = (m_Hwave_lev[lev]) ? m_Hwave_lev[lev]->array(mfi) : Array4<Real> {};
+            const auto Lwave_arr = (m_Lwave_lev[lev]) ? m_Lwave_lev[lev]->array(mfi) : Array4<Real> {};
+            const auto eta_arr   = m_eddyDiffs_lev[lev]->array(mfi);
+
+            auto lmask_arr    = (m_lmask_lev[lev][0])    ? m_lmask_lev[lev][0]->array(mfi) :
+                                                           Array4<int> {};
+
+            reduce_op.eval(gtbx, reduce_data,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept -> ReduceTuple
+            {
+                Real du = 0.0;
+                if (is_land && lmask_arr(i,j,k) == 1) {
+                    du = most_flux.iterate_flux(i, j, k, max_iters, fixed_iters, z0_arr, umm_arr, tm_arr,
+                                                u_star_arr, t_star_arr, t_surf_arr, olen_arr,
+                                                Hwave_arr, Lwave_arr, eta_arr);
+                } else if (!is_land && lmask_arr(i,j,k) == 0) {
+                    du = most_flux.iterate_flux(i, j, k, max_iters, fixed_iters, z0_arr, umm_arr, tm_arr,
+                                                u_star_arr, t_star_arr, t_surf_arr, olen_arr,
+                                                Hwave_arr, Lwave_arr, eta_arr);
+                }
+                return {du};
+            });
+        }
 
-        const auto tm_arr  = tm_ptr->array(mfi);
-        const auto umm_arr = umm_ptr->array(mfi);
-        const auto z0_arr  = z_0[lev].array();
+        if (fixed_iters == 0) return 0.0;
 
-        // Wave properties if they exist
-        const auto Hwave_arr = (m_Hwave_lev[lev]) ? m_Hwave_lev[lev]->array(mfi) : Array4<Real> {};
-        const auto Lwave_arr = (m_Lwave_lev[lev]) ? m_Lwave_lev[lev]->array(mfi) : Array4<Real> {};
-        const auto eta_arr   = m_eddyDiffs_lev[lev]->array(mfi);
+        Real du_max = amrex::get<0>(reduce_data.value(reduce_op));
+        ParallelDescriptor::ReduceRealMax(du_max);
+        return du_max;
+    };
 
-        auto lmask_arr    = (m_lmask_lev[lev][0])    ? m_lmask_lev[lev][0]->array(mfi) :
-                                                       Array4<int> {};
+    if (m_fixed_iters > 0)
+    {
+        Real du_max = iterate(m_fixed_iters);
+        if (du_max <= m_fixed_iters_tol) return;
 
-        ParallelFor(gtbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
-        {
-            if (is_land && lmask_arr(i,j,k) == 1) {
-                most_flux.iterate_flux(i, j, k, max_iters, z0_arr, umm_arr, tm_arr,
-                                       u_star_arr, t_star_arr, t_surf_arr, olen_arr,
-                                       Hwave_arr, Lwave_arr, eta_arr);
-            } else if (!is_land && lmask_arr(i,j,k) == 0) {
-                most_flux.iterate_flux(i, j, k, max_iters, z0_arr, umm_arr, tm_arr,
-                                       u_star_arr, t_star_arr, t_surf_arr, olen_arr,
-                                       Hwave_arr, Lwave_arr, eta_arr);
-            }
-        });
+        amrex::Print() << "MOST u* changed by " << du_max << " in the last of "
+                       << m_fixed_iters << " fixed iterations on level " << lev
+                       << "; iterating to convergence" << std::endl;
     }
+
+    iterate(0);
 }
 
 
@@ -222,6 +258,10 @@ ABLMost::impose_most_bcs (const int& lev,
 /**
  * Function to calculate MOST fluxes for populating ghost cells.
  *
+ * The ghost cells of theta, qv, u and v below the surface are filled by a single
+ * kernel per box: the average and u_star/t_star/t_surf arrays are fetched once per
+ * box, and the cell heights once per point, for all of the variables.
+ *
  * @param[in] lev Current level
  * @param[in,out] mfs Multifabs to populate
  * @param[in] eddyDiffs Diffusion coefficients from turbulence model
@@ -292,91 +332,77 @@ ABLMost::compute_most_bcs (const int& lev,
         auto lsm_flux_arr = (m_lsm_flux_lev[lev][0]) ? m_lsm_flux_lev[lev][0]->array(mfi) :
                                                        Array4<Real> {};
 
-        for (int var_idx = 0; var_idx < Vars::NumTypes; ++var_idx)
+        // Ghost regions below the surface of theta (cell centered), u (x-faces) and v (y-faces)
+        Box b2d  = (*mfs[Vars::cons])[mfi].box();
+        b2d.setBig(2,klo-1);
+        Box xb2d = surroundingNodes((*mfs[Vars::xvel])[mfi].box(),0);
+        xb2d.setBig(2,klo-1);
+        Box yb2d = surroundingNodes((*mfs[Vars::yvel])[mfi].box(),1);
+        yb2d.setBig(2,klo-1);
+
+        // One launch covers all three; each point fills the variables whose region holds it
+        Box gbx = b2d;
+        gbx.minBox(convert(xb2d,b2d.ixType()));
+        gbx.minBox(convert(yb2d,b2d.ixType()));
+
+        auto cons_dest = mfs[Vars::cons]->array(mfi);
+        auto velx_dest = mfs[Vars::xvel]->array(mfi);
+        auto vely_dest = mfs[Vars::yvel]->array(mfi);
+
+        // TODO: Generalize MOST q flux with MOENG & DONELAN flux types
+        bool do_q = (flux_type == FluxCalcType::CUSTOM) && use_moisture;
+
+        ParallelFor(gbx, [=] AMREX_GPU_DEVICE (int i, int j, int k)
         {
-            const Box& bx = (*mfs[var_idx])[mfi].box();
-            auto dest_arr = (*mfs[var_idx])[mfi].array();
-
-            if (var_idx == Vars::cons) {
-                Box b2d = bx;
-                b2d.setBig(2,klo-1);
-                int n = RhoTheta_comp;
-                ParallelFor(b2d, [=] AMREX_GPU_DEVICE (int i, int j, int k)
-                {
-                    Real dz  = (zphys_arr) ? ( zphys_arr(i,j,klo  ) - zphys_arr(i,j,klo-1) ) : dz_no_terrain;
-                    Real dz1 = (zphys_arr) ? ( zphys_arr(i,j,klo+1) - zphys_arr(i,j,klo  ) ) : dz_no_terrain;
-                    Real Tflux = flux_comp.compute_t_flux(i, j, k, n, icomp, dz, dz1, exp_most, eta_arr,
+            Real dz  = (zphys_arr) ? ( zphys_arr(i,j,klo  ) - zphys_arr(i,j,klo-1) ) : dz_no_terrain;
+            Real dz1 = (zphys_arr) ? ( zphys_arr(i,j,klo+1) - zphys_arr(i,j,klo  ) ) : dz_no_terrain;
+
+            if (b2d.contains(i,j,k)) {
+                Real Tflux = flux_comp.compute_t_flux(i, j, k, RhoTheta_comp, icomp, dz, dz1, exp_most, eta_arr,
+                                                      cons_arr, velx_arr, vely_arr,
+                                                      umm_arr, tm_arr, u_star_arr, t_star_arr, t_surf_arr,
+                                                      cons_dest);
+
+                // TODO: make sure not to double-count surface heat flux if using a LSM
+                int is_land = (lmask_arr) ? lmask_arr(i,j,klo) : 1;
+                if (is_land && lsm_flux_arr && vbx.contains(i,j,k)) {
+                    lsm_flux_arr(i,j,klo) = Tflux;
+                }
+                else if ((k == klo-1) && vbx.contains(i,j,k) && exp_most) {
+                    hfx_arr(i,j,klo) = Tflux;
+                }
+
+                if (do_q) {
+                    Real Qflux = flux_comp.compute_q_flux(i, j, k, RhoQ1_comp, icomp, dz, dz1, exp_most, eta_arr,
                                                           cons_arr, velx_arr, vely_arr,
-                                                          umm_arr, tm_arr, u_star_arr, t_star_arr, t_surf_arr,
-                                                          dest_arr);
-
-
-                    // TODO: make sure not to double-count surface heat flux if using a LSM
-                    int is_land = (lmask_arr) ? lmask_arr(i,j,klo) : 1;
-                    if (is_land && lsm_flux_arr && vbx.contains(i,j,k)) {
-                        lsm_flux_arr(i,j,klo) = Tflux;
-                    }
-                    else if ((k == klo-1) && vbx.contains(i,j,k) && exp_most) {
-                        hfx_arr(i,j,klo) = Tflux;
-                    }
-                });
-
-                // TODO: Generalize MOST q flux with MOENG & DONELAN flux types
-                if ((flux_type == FluxCalcType::CUSTOM) && use_moisture) {
-                    n = RhoQ1_comp;
-                    ParallelFor(b2d, [=] AMREX_GPU_DEVICE (int i, int j, int k)
-                    {
-                        Real dz  = (zphys_arr) ? ( zphys_arr(i,j,klo  ) - zphys_arr(i,j,klo-1) ) : dz_no_terrain;
-                        Real dz1 = (zphys_arr) ? ( zphys_arr(i,j,klo+1) - zphys_arr(i,j,klo  ) ) : dz_no_terrain;
-                        Real Qflux = flux_comp.compute_q_flux(i, j, k, n, icomp, dz, dz1, exp_most, eta_arr,
-                                                              cons_arr, velx_arr, vely_arr,
-                                                              umm_arr, qm_arr, u_star_arr, q_star_arr, t_surf_arr,
-                                                              dest_arr);
-                        amrex::ignore_unused(Qflux);
-                    });
+                                                          umm_arr, qm_arr, u_star_arr, q_star_arr, t_surf_arr,
+                                                          cons_dest);
+                    amrex::ignore_unused(Qflux);
                 }
+            }
 
-            } else if (var_idx == Vars::xvel) {
-
-                Box xb2d = surroundingNodes(bx,0);
-                xb2d.setBig(2,klo-1);
-
-                ParallelFor(xb2d, [=] AMREX_GPU_DEVICE (int i, int j, int k)
-                {
-                    Real dz  = (zphys_arr) ? ( zphys_arr(i,j,klo  ) - zphys_arr(i,j,klo-1) ) : dz_no_terrain;
-                    Real dz1 = (zphys_arr) ? ( zphys_arr(i,j,klo+1) - zphys_arr(i,j,klo  ) ) : dz_no_terrain;
-                    Real stressx = flux_comp.compute_u_flux(i, j, k, icomp, dz, dz1, exp_most, eta_arr,
-                                                            cons_arr, velx_arr, vely_arr,
-                                                            umm_arr, um_arr, u_star_arr,
-                                                            dest_arr);
-                    if ((k == klo-1) && vbxx.contains(i,j,k) && exp_most) {
-                        t13_arr(i,j,klo) = -stressx;
-                        if (t31_arr) t31_arr(i,j,klo) = -stressx;
-                    }
-                    amrex::ignore_unused(stressx);
-                });
-
-            } else if (var_idx == Vars::yvel) {
-
-                Box yb2d = surroundingNodes(bx,1);
-                yb2d.setBig(2,klo-1);
-
-                ParallelFor(yb2d, [=] AMREX_GPU_DEVICE (int i, int j, int k)
-                {
-                    Real dz  = (zphys_arr) ? ( zphys_arr(i,j,klo  ) - zphys_arr(i,j,klo-1) ) : dz_no_terrain;
-                    Real dz1 = (zphys_arr) ? ( zphys_arr(i,j,klo+1) - zphys_arr(i,j,klo  ) ) : dz_no_terrain;
-                    Real stressy = flux_comp.compute_v_flux(i, j, k, icomp, dz, dz1, exp_most, eta_arr,
-                                                            cons_arr, velx_arr, vely_arr,
-                                                            umm_arr, vm_arr, u_star_arr,
-                                                            dest_arr);
-                    if ((k == klo-1) && vbxy.contains(i,j,k) && exp_most) {
-                        t23_arr(i,j,klo) = -stressy;
-                        if (t32_arr) t32_arr(i,j,klo) = -stressy;
-                    }
-                    amrex::ignore_unused(stressy);
-                });
+            if (xb2d.contains(i,j,k)) {
+                Real stressx = flux_comp.compute_u_flux(i, j, k, icomp, dz, dz1, exp_most, eta_arr,
+                                                        cons_arr, velx_arr, vely_arr,
+                                                        umm_arr, um_arr, u_star_arr,
+                                                        velx_dest);
+                if ((k == klo-1) && vbxx.contains(i,j,k) && exp_most) {
+                    t13_arr(i,j,klo) = -stressx;
+                    if (t31_arr) t31_arr(i,j,klo) = -stressx;
+                }
             }
-        } // var_idx
+
+            if (yb2d.contains(i,j,k)) {
+                Real stressy = flux_comp.compute_v_flux(i, j, k, icomp, dz, dz1, exp_most, eta_arr,
+                                                        cons_arr, velx_arr, vely_arr,
+                                                        umm_arr, vm_arr, u_star_arr,
+                                                        vely_dest);
+                if ((k == klo-1) && vbxy.contains(i,j,k) && exp_most) {
+                    t23_arr(i,j,klo) = -stressy;
+                    if (t32_arr) t32_arr(i,j,klo) = -stressy;
+                }
+            }
+        });
     } // mfiter
 }
 
@@ -230,13 +230,16 @@ ERF::FillPatchMoistVars (int lev, MultiFab& mf)
  * @param[in]  time           time at which the data should be filled
  * @param[out] mfs_vel        Vector of MultiFabs to be filled containing, in order: cons, xvel, yvel, and zvel
  * @param[out] mfs_mom        Vector of MultiFabs to be filled containing, in order: cons, xmom, ymom, and zmom
- * @param[in]  ng_cons        number of ghost cells to be filled for conserved (cell-centered) variables
+ * @param[in]  ng_cons        number of ghost cells to be filled for conserved (cell-centered) variables;
+ *                            with ghost_trk, each scalar is only filled as deep as the slow rhs reads it
  * @param[in]  ng_vel         number of ghost cells to be filled for velocity components
  * @param[in]  cons_only      if 1 then only fill conserved variables
  * @param[in]  icomp_cons     starting component for conserved variables
  * @param[in]  ncomp_cons     number of components for conserved variables
  * @param[in]  eddyDiffs      diffusion coefficients for LES turbulence models
  * @param[in]  allow_most_bcs if true then use MOST bcs at the low boundary
+ * @param[in,out] ghost_trk  if not null, used to skip components of cons whose ghost cells are
+ *                           already valid, and updated with the ghost cells filled here
  */
 void
 ERF::FillIntermediatePatch (int lev, Real time,
@@ -244,12 +247,29 @@ ERF::FillIntermediatePatch (int lev, Real time,
                             const Vector<MultiFab*>& mfs_mom,     // This includes cc quantities and MOMENTA
                             int ng_cons, int ng_vel, bool cons_only,
                             int icomp_cons, int ncomp_cons,
-                            bool allow_most_bcs)
+                            bool allow_most_bcs, ERFGhostTracker* ghost_trk)
 {
     BL_PROFILE_VAR("FillIntermediatePatch()",FillIntermediatePatch);
     int bccomp;
     Interpolater* mapper;
 
+    //
+    // We only need to fill the components of cons whose ghost cells are stale, and only as deep
+    // as the stencils of the slow rhs read them. Ghost values interpolated from the coarse level
+    // or taken from boundary data depend on time, however, so we only reuse ghost cells when
+    // neither of those is involved; otherwise every component is filled to ng_cons.
+    //
+    Vector<IntVect> ng_comp(ncomp_cons, IntVect(ng_cons));
+    Vector<ERFGhostTracker::Run> cons_runs{{icomp_cons, ncomp_cons, IntVect(ng_cons)}};
+    bool time_dependent_ghosts = (lev > 0) || use_real_bcs || (m_r2d != nullptr);
+    if (ghost_trk && !time_dependent_ghosts) {
+        for (int n = 0; n < ncomp_cons; ++n) {
+            ng_comp[n] = IntVect(std::min(ng_cons, ComputeConsGhostCells(icomp_cons+n)));
+        }
+        cons_runs = ghost_trk->stale_runs(IntVars::cons, icomp_cons, ng_comp);
+        if (cons_only && cons_runs.empty()) { return; }
+    }
+
     //
     // ***************************************************************************
     // The first thing we do is interpolate the momenta on the "valid" faces of
@@ -343,7 +363,13 @@ ERF::FillIntermediatePatch (int lev, Real time,
         if (lev == 0)
         {
             // This fills fine-fine ghost values of cons and VELOCITY (not momentum)
-            mf.FillBoundary(icomp,ncomp,ngvect,geom[lev].periodicity());
+            if (var_idx == Vars::cons) {
+                for (auto const& run : cons_runs) {
+                    mf.FillBoundary(run.scomp,run.ncomp,run.ng,geom[lev].periodicity());
+                }
+            } else {
+                mf.FillBoundary(icomp,ncomp,ngvect,geom[lev].periodicity());
+            }
         }
         else
         {
@@ -392,7 +418,6 @@ ERF::FillIntermediatePatch (int lev, Real time,
     // ***************************************************************************
     // Physical bc's at domain boundary
     // ***************************************************************************
-    IntVect ngvect_cons = IntVect(ng_cons,ng_cons,ng_cons);
     IntVect ngvect_vels = IntVect(ng_vel ,ng_vel ,ng_vel);
 
 #ifdef ERF_USE_NETCDF
@@ -405,7 +430,9 @@ ERF::FillIntermediatePatch (int lev, Real time,
     if (m_r2d) fill_from_bndryregs(mfs_vel,time);
 
     // We call this even if init_type == real because this routine will fill the vertical bcs
-    (*physbcs_cons[lev])(*mfs_vel[Vars::cons],icomp_cons,ncomp_cons,ngvect_cons,time,BCVars::cons_bc);
+    for (auto const& run : cons_runs) {
+        (*physbcs_cons[lev])(*mfs_vel[Vars::cons],run.scomp,run.ncomp,run.ng,time,BCVars::cons_bc);
+    }
     if (!cons_only) {
         (*physbcs_u[lev])(*mfs_vel[Vars::xvel],0,1,ngvect_vels,time,BCVars::xvel_bc);
         (*physbcs_v[lev])(*mfs_vel[Vars::yvel],0,1,ngvect_vels,time,BCVars::yvel_bc);
@@ -443,6 +470,20 @@ ERF::FillIntermediatePatch (int lev, Real time,
                            *mfs_mom[IntVars::xmom], *mfs_mom[IntVars::ymom], *mfs_mom[IntVars::zmom],
                            Geom(lev).Domain(),
                            domain_bcs_type);
+
+        if (ghost_trk) {
+            // Velocity is only filled to ngvect_vels (and not at all in z for w) so the
+            //    momenta are only consistent where both were filled
+            ghost_trk->set_valid(IntVars::xmom, amrex::min(ngu, ngvect_vels));
+            ghost_trk->set_valid(IntVars::ymom, amrex::min(ngv, ngvect_vels));
+            ghost_trk->set_valid(IntVars::zmom, amrex::min(ngw, IntVect(ng_vel,ng_vel,0)));
+        }
+    }
+
+    if (ghost_trk) {
+        for (int n = 0; n < ncomp_cons; ++n) {
+            ghost_trk->set_valid(IntVars::cons, icomp_cons+n, 1, ng_comp[n]);
+        }
     }
 }
 
@@ -72,7 +72,8 @@ void ERFFillPatcher::Define (BoxArray const& fba, DistributionMapping const& fdm
     m_nghost = nghost; m_nghost_subset = nghost_set;
     m_ncomp  = ncomp;  m_interp = interp;
 
-    // Delete old MFs if they exist
+    // Delete old MFs if they exist (after any outstanding copy into them has landed)
+    FinishRegisterCoarseData();
     if (m_cf_crse_data_old) m_cf_crse_data_old.reset();
     if (m_cf_crse_data_new) m_cf_crse_data_new.reset();
     if (m_cf_mask) m_cf_mask.reset();
@@ -178,6 +179,9 @@ void ERFFillPatcher::BuildMask (BoxArray const& fba,
 
 /*
  * Register the coarse data to be used by the ERFFillPatcher
+ * NOTE: this only starts the copies into m_cf_crse_data_old/new; they are
+ *       completed by FinishRegisterCoarseData, which is called lazily the first
+ *       time the fine level asks for the data in Fill
  *
  * @param[in] crse_data data at old and new time at coarse level
  * @param[in] crse_time times at which crse_data is defined
@@ -189,17 +193,24 @@ void ERFFillPatcher::RegisterCoarseData (Vector<MultiFab const*> const& crse_dat
     AMREX_ALWAYS_ASSERT(crse_data.size() == 2); // old and new
     AMREX_ALWAYS_ASSERT(crse_time[1] >= crse_time[0]);
 
+    // We only have one set of buffers so an outstanding copy must land first
+    FinishRegisterCoarseData();
+
     // NOTE: CoarseBox with CellConsLinear interpolation grows the
     //       box by 1 in all directions. This pushes the domain for
     //       m_cf_crse_data into ghost cells in the z-dir. So we need
-    //       to include ghost cells for crse_data when doing the copy
-    IntVect src_ng = crse_data[0]->nGrowVect();
+    //       to include ghost cells for crse_data when doing the copy,
+    //       but never more than the one layer that CoarseBox can reach
+    IntVect src_ng = CrseNGrowVect(*(crse_data[0]));
     IntVect dst_ng = m_cf_crse_data_old->nGrowVect();
 
-    m_cf_crse_data_old->ParallelCopy(*(crse_data[0]), 0, 0, m_ncomp,
-                                    src_ng, dst_ng, m_cgeom.periodicity()); // old data
-    m_cf_crse_data_new->ParallelCopy(*(crse_data[1]), 0, 0, m_ncomp,
-                                    src_ng, dst_ng, m_cgeom.periodicity()); // new data
+    // The source data is packed (and local copies are done) before these
+    // return, so crse_data may be modified or go out of scope afterwards
+    m_cf_crse_data_old->ParallelCopy_nowait(*(crse_data[0]), 0, 0, m_ncomp,
+                                            src_ng, dst_ng, m_cgeom.periodicity()); // old data
+    m_cf_crse_data_new->ParallelCopy_nowait(*(crse_data[1]), 0, 0, m_ncomp,
+                                            src_ng, dst_ng, m_cgeom.periodicity()); // new data
+    m_copy_pending = true;
 
     m_crse_times[0] = crse_time[0]; // time of "old" coarse data
     m_crse_times[1] = crse_time[1]; // time of "new" coarse data
@@ -207,6 +218,20 @@ void ERFFillPatcher::RegisterCoarseData (Vector<MultiFab const*> const& crse_dat
     m_dt_crse = crse_time[1] - crse_time[0];
 }
 
+/*
+ * Complete the copies of the coarse data started in RegisterCoarseData (if any)
+ */
+
+void ERFFillPatcher::FinishRegisterCoarseData ()
+{
+    if (m_copy_pending) {
+        BL_PROFILE("ERFFillPatcher::FinishRegisterCoarseData()");
+        m_cf_crse_data_old->ParallelCopy_finish();
+        m_cf_crse_data_new->ParallelCopy_finish();
+        m_copy_pending = false;
+    }
+}
+
 void ERFFillPatcher::InterpFace (MultiFab& fine,
                                  MultiFab const& crse,
                                  int mask_val)
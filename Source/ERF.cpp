@@ -81,6 +81,13 @@ Real ERF::column_loc_x     = 0.0;
 Real ERF::column_loc_y     = 0.0;
 std::string ERF::column_file_name = "column_data.nc";
 
+#ifdef ERF_USE_WINDFARM
+// Per-turbine time series of the wind farm
+int  ERF::windfarm_output_interval = -1;
+Real ERF::windfarm_output_per      = -1.0;
+std::string ERF::windfarm_output_file = "turbine_time_series.csv";
+#endif
+
 // 2D BndryRegister output (for ingestion by AMR-Wind)
 int  ERF::output_bndry_planes            = 0;
 int  ERF::bndry_output_planes_interval   = -1;
@@ -121,11 +128,13 @@ ERF::ERF ()
 
 #ifdef ERF_USE_WINDFARM
     Nturb.resize(nlevs_max);
-    vars_windfarm.resize(nlevs_max);
 #endif
 
 #if defined(ERF_USE_RRTMGP)
     qheating_rates.resize(nlevs_max);
+    qheating_rates_prev.resize(nlevs_max);
+    qheating_rates_last.resize(nlevs_max);
+    rad_last_time.resize(nlevs_max, -1.0);
     sw_lw_fluxes.resize(nlevs_max);
     solar_zenith.resize(nlevs_max);
 #endif
@@ -202,6 +211,9 @@ ERF::ERF ()
     rV_old.resize(nlevs_max);
     rW_old.resize(nlevs_max);
 
+    ghosts_old.resize(nlevs_max);
+    ghosts_new.resize(nlevs_max);
+
     for (int lev = 0; lev < nlevs_max; ++lev) {
         vars_new[lev].resize(Vars::NumTypes);
         vars_old[lev].resize(Vars::NumTypes);
@@ -536,6 +548,17 @@ ERF::post_timestep (int nstep, Real time, Real dt_lev0)
       }
     }
 
+#ifdef ERF_USE_WINDFARM
+    if (solverChoice.windfarm_type != WindFarmType::None &&
+        is_it_time_for_action(nstep, time, dt_lev0, windfarm_output_interval, windfarm_output_per))
+    {
+        // All the turbines are on the coarsest level
+        windfarm->write_turbine_time_series(geom[0], time, vars_new[0][Vars::cons],
+                                            vars_new[0][Vars::xvel], vars_new[0][Vars::yvel],
+                                            windfarm_output_file);
+    }
+#endif
+
     // Moving terrain
     if ( solverChoice.use_terrain &&  (solverChoice.terrain_type == TerrainType::Moving) )
     {
@@ -1115,6 +1138,12 @@ ERF::initializeMicrophysics (const int& a_nlevsmax /*!< number of AMR levels */)
     } else if (Microphysics::modelType(solverChoice.moisture_type) == MoistureModelType::Lagrangian) {
 #ifdef ERF_USE_PARTICLES
 
+        // ParticleData::Restart would rebuild the model's particles as a plain ERFPC
+        //    and drop the attributes it adds, so we do not restart these models yet
+        if (!restart_chkfile.empty()) {
+            Abort("Restarting from a checkpoint is not supported with Lagrangian microphysics");
+        }
+
         micro = std::make_unique<LagrangianMicrophysics>(a_nlevsmax, solverChoice.moisture_type);
         /* Lagrangian microphysics models will have a particle container; it needs to be added
            to ERF::particleData */
@@ -1305,6 +1334,19 @@ ERF::ReadParameters ()
 
         pp.query("pert_interval", pert_interval);
 
+#if defined(ERF_USE_RRTMGP)
+        // Frequency of the radiation calls and treatment of the heating rates in between
+        pp.query("radiation_period", rad_period);
+        std::string rad_interp_string = "hold";
+        pp.query("radiation_interp", rad_interp_string);
+        if (rad_interp_string == "linear") {
+            rad_interp_linear = true;
+        } else if (rad_interp_string != "hold") {
+            Abort("radiation_interp must be hold or linear");
+        }
+        pp.query("radiation_update_zenith", rad_update_zenith);
+#endif
+
         // Time step controls
         pp.query("cfl", cfl);
         pp.query("init_shrink", init_shrink);
@@ -1448,6 +1490,12 @@ ERF::ReadParameters ()
         pp.query("column_loc_y", column_loc_y);
         pp.query("column_file_name", column_file_name);
 
+#ifdef ERF_USE_WINDFARM
+        pp.query("windfarm_output_interval", windfarm_output_interval);
+        pp.query("windfarm_output_per", windfarm_output_per);
+        pp.query("windfarm_output_file", windfarm_output_file);
+#endif
+
         // Specify information about outputting planes of data
         pp.query("output_bndry_planes", output_bndry_planes);
         pp.query("bndry_output_planes_interval", bndry_output_planes_interval);
@@ -1859,11 +1907,13 @@ ERF::ERF (const RealBox& rb, int max_level_in,
 
 #ifdef ERF_USE_WINDFARM
     Nturb.resize(nlevs_max);
-    vars_windfarm.resize(nlevs_max);
 #endif
 
 #if defined(ERF_USE_RRTMGP)
     qheating_rates.resize(nlevs_max);
+    qheating_rates_prev.resize(nlevs_max);
+    qheating_rates_last.resize(nlevs_max);
+    rad_last_time.resize(nlevs_max, -1.0);
     sw_lw_fluxes.resize(nlevs_max);
     solar_zenith.resize(nlevs_max);
 #endif
@@ -234,18 +234,10 @@ ERF::init_stuff (int lev, const BoxArray& ba, const DistributionMapping& dm,
 
 #if defined(ERF_USE_WINDFARM)
     //*********************************************************
-    // Variables for Ftich model for windfarm parametrization
+    // Variables for the windfarm parametrizations; the source terms
+    // are only stored in the rotor footprints, by the model
     //*********************************************************
-    if (solverChoice.windfarm_type == WindFarmType::Fitch){
-        vars_windfarm[lev].define(ba, dm, 5, ngrow_state); // V, dVabsdt, dudt, dvdt, dTKEdt
-        Nturb[lev].define(ba, dm, 1, ngrow_state); // Number of turbines in a cell
-    }
-    if (solverChoice.windfarm_type == WindFarmType::EWP){
-        vars_windfarm[lev].define(ba, dm, 3, ngrow_state); // dudt, dvdt, dTKEdt
-        Nturb[lev].define(ba, dm, 1, ngrow_state); // Number of turbines in a cell
-    }
-    if (solverChoice.windfarm_type == WindFarmType::SimpleAD) {
-        vars_windfarm[lev].define(ba, dm, 2, ngrow_state);// dudt, dvdt
+    if (solverChoice.windfarm_type != WindFarmType::None) {
         Nturb[lev].define(ba, dm, 1, ngrow_state); // Number of turbines in a cell
     }
 #endif
@@ -290,6 +282,15 @@ ERF::init_stuff (int lev, const BoxArray& ba, const DistributionMapping& dm,
     qheating_rates[lev] = std::make_unique<MultiFab>(ba, dm, 2, ngrow_state);
     qheating_rates[lev]->setVal(0.);
 
+    // Heating rates kept between radiation calls; the new grids need a call
+    if (rad_period > 0.0) {
+        qheating_rates_last[lev] = std::make_unique<MultiFab>(ba, dm, 2, 0);
+        if (rad_interp_linear) {
+            qheating_rates_prev[lev] = std::make_unique<MultiFab>(ba, dm, 2, 0);
+        }
+    }
+    rad_last_time[lev] = -1.0;
+
     //*********************************************************
     // Radiation fluxes for coupling to LSM
     //*********************************************************
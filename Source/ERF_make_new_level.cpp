@@ -316,6 +316,15 @@ ERF::MakeNewLevelFromCoarse (int lev, Real time, const BoxArray& ba,
         qmoist[lev][mvar] = micro->Get_Qmoist_Ptr(lev,mvar);
     }
 
+#ifdef ERF_USE_WINDFARM
+    // ********************************************************************************************
+    // Number of turbines per cell on the new grids
+    // ********************************************************************************************
+    if (solverChoice.windfarm_type != WindFarmType::None) {
+        windfarm->fill_Nturb_multifab(geom[lev], Nturb[lev]);
+    }
+#endif
+
     // ********************************************************************************************
     // Update the base state at this level
     // ********************************************************************************************
@@ -455,6 +464,15 @@ ERF::RemakeLevel (int lev, Real time, const BoxArray& ba, const DistributionMapp
         qmoist[lev][mvar] = micro->Get_Qmoist_Ptr(lev,mvar);
     }
 
+#ifdef ERF_USE_WINDFARM
+    // ********************************************************************************************
+    // Number of turbines per cell on the new grids
+    // ********************************************************************************************
+    if (solverChoice.windfarm_type != WindFarmType::None) {
+        windfarm->fill_Nturb_multifab(geom[lev], Nturb[lev]);
+    }
+#endif
+
     // ********************************************************************************************
     // Update the base state at this level
     // ********************************************************************************************
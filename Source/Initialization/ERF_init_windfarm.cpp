@@ -28,11 +28,17 @@ ERF::init_windfarm (int lev)
                              true, false);
     }
 
+    // Bucket the turbines by cell and weigh the rotors in the levels once;
+    // both only depend on the domain, so they are kept across regrids
+    windfarm->set_turb_index(geom[lev]);
+    windfarm->set_rotor_weights(geom[lev]);
+
     windfarm->fill_Nturb_multifab(geom[lev], Nturb[lev]);
 
     windfarm->write_turbine_locations_vtk();
 
-    if(solverChoice.windfarm_type == WindFarmType::SimpleAD) {
+    if(solverChoice.windfarm_type == WindFarmType::SimpleAD ||
+       solverChoice.windfarm_type == WindFarmType::ActuatorLine) {
         windfarm->write_actuator_disks_vtk();
     }
 }
@@ -44,9 +50,8 @@ ERF::advance_windfarm (const Geometry& a_geom,
                        MultiFab& U_old,
                        MultiFab& V_old,
                        MultiFab& W_old,
-                       MultiFab& mf_vars_windfarm,
                        const MultiFab& mf_Nturb)
 {
-        windfarm->advance(a_geom, dt_advance, cons_in, mf_vars_windfarm,
+        windfarm->advance(a_geom, dt_advance, cons_in,
                           U_old, V_old, W_old, mf_Nturb);
 }
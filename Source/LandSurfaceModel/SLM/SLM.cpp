@@ -77,48 +77,28 @@ SLM::ComputeTsurf ()
     }
 }
 
-/* Compute the diffusive fluxes */
+/* Advance the solution with a backward Euler step, one tridiagonal solve per column */
 void
-SLM::ComputeFluxes ()
+SLM::AdvanceSLM ()
 {
     // Expose for GPU copy
     int khi = khi_lsm;
+    int klo = khi_lsm - m_nz_lsm + 1;
     Real Dsoil = m_d_soil;
     Real dzInv = m_lsm_geom.InvCellSize(2);
-
-    for ( MFIter mfi(*(lsm_fab_flux[LsmVar_SLM::theta])); mfi.isValid(); ++mfi) {
-        auto box3d = mfi.tilebox();
-
-        // Do not overwrite the flux at the top (comes from MOST BC)
-        if (box3d.bigEnd(2) == khi+1) box3d.setBig(2,khi);
-
-        auto theta_array = lsm_fab_vars[LsmVar_SLM::theta]->array(mfi);
-        auto theta_flux  = lsm_fab_flux[LsmVar_SLM::theta]->array(mfi);
-
-        ParallelFor( box3d, [=] AMREX_GPU_DEVICE (int i, int j, int k)
-        {
-            theta_flux(i,j,k) = Dsoil * ( theta_array(i,j,k) - theta_array(i,j,k-1) ) * dzInv;
-        });
-    }
-}
-
-/* Advance the solution with a simple explicit update (should use tridiagonal solve) */
-void
-SLM::AdvanceSLM ()
-{
-    // Expose for GPU copy
-    Real dt = m_dt;
-    Real dzInv = m_lsm_geom.InvCellSize(2);
+    Real dtdz  = m_dt * dzInv;
+    Real r     = Dsoil * m_dt * dzInv * dzInv;
 
     for ( MFIter mfi(*(lsm_fab_vars[LsmVar_SLM::theta])); mfi.isValid(); ++mfi) {
-        auto box3d = mfi.tilebox();
+        auto box2d = mfi.tilebox(); box2d.makeSlab(2,khi);
 
         auto theta_array = lsm_fab_vars[LsmVar_SLM::theta]->array(mfi);
         auto theta_flux  = lsm_fab_flux[LsmVar_SLM::theta]->array(mfi);
 
-        ParallelFor( box3d, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        ParallelFor( box2d, [=] AMREX_GPU_DEVICE (int i, int j, int )
         {
-            theta_array(i,j,k) += dt * ( theta_flux(i,j,k+1) - theta_flux(i,j,k) ) * dzInv;
+            soil_column_implicit_diffusion(i, j, klo, khi, r, dtdz, dzInv, Dsoil,
+                                           theta_array, theta_flux);
         });
     }
 }
@@ -36,13 +36,30 @@ void Kessler::Init (const MultiFab& cons_in,
     MicVarMap.resize(m_qmoist_size);
     MicVarMap = {MicVar_Kess::qt, MicVar_Kess::qv, MicVar_Kess::qcl, MicVar_Kess::qp, MicVar_Kess::rain_accum};
 
-    // initialize microphysics variables
+    // initialize microphysics variables; the density is not allocated since it
+    // is a view of the conserved state (see Copy_State_to_Micro)
     for (auto ivar = 0; ivar < MicVar_Kess::NumVars; ++ivar) {
+        if (ivar == MicVar_Kess::rho) continue;
         mic_fab_vars[ivar] = std::make_shared<MultiFab>(cons_in.boxArray(), cons_in.DistributionMap(),
                                                         1, cons_in.nGrowVect());
         mic_fab_vars[ivar]->setVal(0.);
     }
 
+    // Init is called again on regrid, so drop any view of the old state right away
+    mic_fab_vars[MicVar_Kess::rho] = std::make_shared<MultiFab>(cons_in, make_alias, Rho_comp, 1);
+    m_tiles.define(*mic_fab_vars[MicVar_Kess::tabs]);
+
+    // The sedimentation has to exchange the rain between the boxes of a column
+    //    if the columns are split (see AdvanceKessler)
+    const Box& domain = geom.Domain();
+    const BoxArray& ba = cons_in.boxArray();
+    m_split_columns = false;
+    for (int i = 0; i < ba.size(); ++i) {
+        if (ba[i].smallEnd(2) != domain.smallEnd(2) || ba[i].bigEnd(2) != domain.bigEnd(2)) {
+            m_split_columns = true;
+        }
+    }
+
     // Set class data members
     for ( MFIter mfi(cons_in, TileNoZ()); mfi.isValid(); ++mfi) {
         const auto& box3d = mfi.tilebox();
@@ -63,7 +80,15 @@ void Kessler::Init (const MultiFab& cons_in,
  */
 void Kessler::Copy_State_to_Micro (const MultiFab& cons_in)
 {
-    // Get the temperature, density, theta, qt and qp from input
+    // The density is used as is, so alias it rather than copying it. The alias
+    // is rebuilt on every call since the state MultiFabs are swapped between
+    // steps and replaced on regrid. The other variables cannot be views of the
+    // state: the state holds rho*theta and rho*q, the microphysics updates theta
+    // and the mixing ratios (qv, qcl and qp) in place, and tabs and pres are
+    // not part of the state.
+    mic_fab_vars[MicVar_Kess::rho] = std::make_shared<MultiFab>(cons_in, make_alias, Rho_comp, 1);
+
+    // Get the temperature, theta, qt and qp from input
     for ( MFIter mfi(cons_in); mfi.isValid(); ++mfi) {
         const auto& box3d = mfi.tilebox();
 
@@ -75,15 +100,13 @@ void Kessler::Copy_State_to_Micro (const MultiFab& cons_in)
 
         auto qp_array    = mic_fab_vars[MicVar_Kess::qp]->array(mfi);
 
-        auto rho_array   = mic_fab_vars[MicVar_Kess::rho]->array(mfi);
         auto theta_array = mic_fab_vars[MicVar_Kess::theta]->array(mfi);
         auto tabs_array  = mic_fab_vars[MicVar_Kess::tabs]->array(mfi);
         auto pres_array  = mic_fab_vars[MicVar_Kess::pres]->array(mfi);
 
-        // Get pressure, theta, temperature, density, and qt, qp
+        // Get pressure, theta, temperature, and qt, qp
         ParallelFor( box3d, [=] AMREX_GPU_DEVICE (int i, int j, int k)
         {
-            rho_array(i,j,k)   = states_array(i,j,k,Rho_comp);
             theta_array(i,j,k) = states_array(i,j,k,RhoTheta_comp)/states_array(i,j,k,Rho_comp);
             qv_array(i,j,k)    = states_array(i,j,k,RhoQ1_comp)/states_array(i,j,k,Rho_comp);
             qc_array(i,j,k)    = states_array(i,j,k,RhoQ2_comp)/states_array(i,j,k,Rho_comp);
@@ -1,193 +1,378 @@
+#include <iomanip>
+
 #include <EOS.H>
 #include <TileNoZ.H>
+#include <ActiveColumns.H>
 #include "Kessler.H"
 #include "DataStruct.H"
 
 using namespace amrex;
 
+namespace {
+
 /**
- * Compute Precipitation-related Microphysics quantities.
+ * Sedimentation of the rain down a column of one box
  */
-void Kessler::AdvanceKessler (const SolverChoice &solverChoice)
+struct KesslerRainFall
 {
-    auto tabs  = mic_fab_vars[MicVar_Kess::tabs];
-    if (solverChoice.moisture_type == MoistureType::Kessler){
-        auto dz = m_geom.CellSize(2);
-        auto domain = m_geom.Domain();
-        int k_lo = domain.smallEnd(2);
-        int k_hi = domain.bigEnd(2);
+    Array4<const Real> rho_array, dJ_array;
+    Array4<Real> qp_array, rain_accum_array;
+    Real dz;
+    int k_lo, k_hi;
+
+    /** Flux through the lower face of cell k, and the fall speed there */
+    AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+    Real face_flux (int i, int j, int k, Real& V_terminal) const noexcept
+    {
+        Real rho_avg, qp_avg;
+
+        if (k==k_lo) {
+            rho_avg = rho_array(i,j,k);
+            qp_avg  = qp_array(i,j,k);
+        } else if (k==k_hi+1) {
+            rho_avg = rho_array(i,j,k-1);
+            qp_avg  = qp_array(i,j,k-1);
+        } else {
+            rho_avg = 0.5*(rho_array(i,j,k-1) + rho_array(i,j,k)); // Convert to g/cm^3
+            qp_avg = 0.5*(qp_array(i,j,k-1)  + qp_array(i,j,k));
+        }
 
-        MultiFab fz;
-        auto ba    = tabs->boxArray();
-        auto dm    = tabs->DistributionMap();
-        fz.define(convert(ba, IntVect(0,0,1)), dm, 1, 0); // No ghost cells
+        qp_avg = std::max(0.0, qp_avg);
 
-        Real dtn = dt;
+        V_terminal = 36.34*std::pow(rho_avg*0.001*qp_avg, 0.1346)*std::pow(rho_avg/1.16, -0.5); // in m/s
 
-        for ( MFIter mfi(fz, TilingIfNotGPU()); mfi.isValid(); ++mfi ){
-            auto rho_array = mic_fab_vars[MicVar_Kess::rho]->array(mfi);
-            auto qp_array  = mic_fab_vars[MicVar_Kess::qp]->array(mfi);
-            auto rain_accum_array = mic_fab_vars[MicVar_Kess::rain_accum]->array(mfi);
+        // NOTE: Fz is the sedimentation flux from the advective operator.
+        //       In the terrain-following coordinate system, the z-deriv in
+        //       the divergence uses the normal velocity (Omega). However,
+        //       there are no u/v components to the sedimentation velocity.
+        //       Therefore, we simply end up with a division by detJ when
+        //       evaluating the source term: dJinv * (flux_hi - flux_lo) * dzinv.
+        return rho_avg*V_terminal*qp_avg;
+    }
 
-            auto fz_array  = fz.array(mfi);
-            const Box& tbz = mfi.tilebox();
+    /** Courant number of the rain falling through the lower face of cell k in a time dtn */
+    AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+    Real courant (int i, int j, int k, Real dtn) const noexcept
+    {
+        Real V_terminal;
+        face_flux(i, j, k, V_terminal);
+        Real dJinv = (dJ_array) ? 1.0/dJ_array(i,j,k) : 1.0;
+        return V_terminal*dJinv*dtn/dz;
+    }
 
-            ParallelFor(tbz, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
-            {
-                Real rho_avg, qp_avg;
-
-                if (k==k_lo) {
-                    rho_avg = rho_array(i,j,k);
-                    qp_avg  = qp_array(i,j,k);
-                } else if (k==k_hi+1) {
-                    rho_avg = rho_array(i,j,k-1);
-                    qp_avg  = qp_array(i,j,k-1);
-                } else {
-                    rho_avg = 0.5*(rho_array(i,j,k-1) + rho_array(i,j,k)); // Convert to g/cm^3
-                    qp_avg = 0.5*(qp_array(i,j,k-1)  + qp_array(i,j,k));
-                }
+    /** nsub substeps of length dts over the cells klo..khi of column (i,j) */
+    AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+    void operator() (int i, int j, int klo, int khi, int nsub, Real dts) const noexcept
+    {
+        Real V_terminal;
 
-                qp_avg = std::max(0.0, qp_avg);
+        for (int n = 0; n < nsub; ++n) {
+            Real fz_lo = face_flux(i, j, klo, V_terminal);
 
-                Real V_terminal = 36.34*std::pow(rho_avg*0.001*qp_avg, 0.1346)*std::pow(rho_avg/1.16, -0.5); // in m/s
+            if (klo==k_lo) {
+                rain_accum_array(i,j,klo) = rain_accum_array(i,j,klo) + fz_lo*dts/1000.0*1000.0; // Divide by rho_water and convert to mm
+            }
+            if(std::fabs(fz_lo) < 1e-14) fz_lo = 0.0;
 
-                // NOTE: Fz is the sedimentation flux from the advective operator.
-                //       In the terrain-following coordinate system, the z-deriv in
-                //       the divergence uses the normal velocity (Omega). However,
-                //       there are no u/v components to the sedimentation velocity.
-                //       Therefore, we simply end up with a division by detJ when
-                //       evaluating the source term: dJinv * (flux_hi - flux_lo) * dzinv.
-                fz_array(i,j,k) = rho_avg*V_terminal*qp_avg;
+            // The flux through the upper face of cell k is computed before cell k is
+            // updated, so both fluxes of a cell see the state at the start of the substep
+            for (int k = klo; k <= khi; ++k) {
+                Real fz_hi = face_flux(i, j, k+1, V_terminal);
+                if(std::fabs(fz_hi) < 1e-14) fz_hi = 0.0;
 
-                if(k==k_lo){
-                    rain_accum_array(i,j,k) = rain_accum_array(i,j,k) + rho_avg*qp_avg*V_terminal*dtn/1000.0*1000.0; // Divide by rho_water and convert to mm
-                }
+                // Jacobian determinant
+                Real dJinv = (dJ_array) ? 1.0/dJ_array(i,j,k) : 1.0;
 
-                /*if(k==0){
-                  fz_array(i,j,k) = 0;
-                  }*/
-            });
-        }
+                Real dq_sed = dts * dJinv * (1.0/rho_array(i,j,k)) * (fz_hi - fz_lo)/dz;
+                if(std::fabs(dq_sed) < 1e-14) dq_sed = 0.0;
 
-        for ( MFIter mfi(*tabs,TilingIfNotGPU()); mfi.isValid(); ++mfi) {
-            auto qv_array    = mic_fab_vars[MicVar_Kess::qv]->array(mfi);
-            auto qc_array    = mic_fab_vars[MicVar_Kess::qcl]->array(mfi);
-            auto qp_array    = mic_fab_vars[MicVar_Kess::qp]->array(mfi);
-            auto qt_array    = mic_fab_vars[MicVar_Kess::qt]->array(mfi);
-            auto tabs_array  = mic_fab_vars[MicVar_Kess::tabs]->array(mfi);
-            auto pres_array  = mic_fab_vars[MicVar_Kess::pres]->array(mfi);
-            auto theta_array = mic_fab_vars[MicVar_Kess::theta]->array(mfi);
-            auto rho_array   = mic_fab_vars[MicVar_Kess::rho]->array(mfi);
+                qp_array(i,j,k) += dq_sed;
+                fz_lo = fz_hi;
+            }
+        }
+    }
+};
 
-            const auto dJ_array = (m_detJ_cc) ? m_detJ_cc->const_array(mfi) : Array4<const Real>{};
+}
 
-            const auto& box3d = mfi.tilebox();
+/**
+ * Compute Precipitation-related Microphysics quantities.
+ */
+void Kessler::AdvanceKessler (const SolverChoice &solverChoice)
+{
+    auto tabs  = mic_fab_vars[MicVar_Kess::tabs];
+    if (solverChoice.moisture_type == MoistureType::Kessler){
+        auto dz = m_geom.CellSize(2);
+        auto domain = m_geom.Domain();
+        int k_lo = domain.smallEnd(2);
+        int k_hi = domain.bigEnd(2);
 
-            auto fz_array  = fz.array(mfi);
+        Real dtn = dt;
+        Real max_cfl = solverChoice.sed_max_cfl;
+
+        // Sedimentation of the rain, done on a copy of qp so the source terms below
+        // still see the rain at the start of the step. Each column takes as many
+        // substeps as its fastest falling rain needs to keep the Courant number
+        // below max_cfl, so a few columns with heavy rain do not limit the time
+        // step of the whole model.
+        MultiFab qp_sed;
+        auto ba    = tabs->boxArray();
+        auto dm    = tabs->DistributionMap();
+        auto ngrow = tabs->nGrowVect();
+        qp_sed.define(ba, dm, 1, ngrow);
+        MultiFab::Copy(qp_sed, *mic_fab_vars[MicVar_Kess::qp], 0, 0, 1, ngrow);
+
+        // The rain only lives on the valid cells; the fluxes through the top and
+        // bottom faces of a box read it in the boxes above and below
+        qp_sed.FillBoundary(m_geom.periodicity());
+
+        // The density is a view of the state, whose ghost cells may be stale here,
+        // so the faces between the boxes of a split column read it from a copy
+        MultiFab rho_sed;
+        if (m_split_columns) {
+            rho_sed.define(ba, dm, 1, ngrow);
+            MultiFab::Copy(rho_sed, *mic_fab_vars[MicVar_Kess::rho], 0, 0, 1, 0);
+            rho_sed.FillBoundary(m_geom.periodicity());
+        }
 
-            // Expose for GPU
-            Real d_fac_cond = m_fac_cond;
+        auto rain_fall = [&] (int box_no) -> KesslerRainFall
+        {
+            KesslerRainFall fall;
+            fall.rho_array        = (m_split_columns) ? rho_sed.const_array(box_no)
+                                                      : mic_fab_vars[MicVar_Kess::rho]->const_array(box_no);
+            fall.dJ_array         = (m_detJ_cc) ? m_detJ_cc->const_array(box_no) : Array4<const Real>{};
+            fall.qp_array         = qp_sed.array(box_no);
+            fall.rain_accum_array = mic_fab_vars[MicVar_Kess::rain_accum]->array(box_no);
+            fall.dz   = dz;
+            fall.k_lo = k_lo;
+            fall.k_hi = k_hi;
+            return fall;
+        };
+
+        // Rain in the air and on the ground, in kg (a mm of rain is a kg per m^2)
+        auto rain_mass = [&] () -> Real
+        {
+            const auto dx = m_geom.CellSizeArray();
+            ReduceOps<ReduceOpSum> reduce_op;
+            ReduceData<Real> reduce_data(reduce_op);
+            using ReduceTuple = typename decltype(reduce_data)::Type;
+            for (MFIter mfi(qp_sed, TileNoZ()); mfi.isValid(); ++mfi) {
+                const KesslerRainFall fall = rain_fall(mfi.index());
+                reduce_op.eval(mfi.tilebox(), reduce_data,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept -> ReduceTuple
+                {
+                    Real dJ   = (fall.dJ_array) ? fall.dJ_array(i,j,k) : 1.0;
+                    Real mass = fall.rho_array(i,j,k) * fall.qp_array(i,j,k) * dJ * dz;
+                    if (k == k_lo) { mass += fall.rain_accum_array(i,j,k); }
+                    return {mass};
+                });
+            }
+            Real mass = amrex::get<0>(reduce_data.value(reduce_op)) * dx[0] * dx[1];
+            ParallelDescriptor::ReduceRealSum(mass);
+            return mass;
+        };
+
+        Real mass_before = (m_verbose > 0) ? rain_mass() : 0.0;
+
+        // When the columns are split between boxes, the boxes of a column must take the
+        // same substeps and compute the same flux through the faces between them. All the
+        // columns then take the substeps of the fastest falling rain of the level, and the
+        // rain in the ghost cells is refreshed before every substep.
+        if (m_split_columns) {
+            ReduceOps<ReduceOpMax> reduce_op;
+            ReduceData<Real> reduce_data(reduce_op);
+            using ReduceTuple = typename decltype(reduce_data)::Type;
+            for (MFIter mfi(qp_sed, TileNoZ()); mfi.isValid(); ++mfi) {
+                const KesslerRainFall fall = rain_fall(mfi.index());
+                reduce_op.eval(mfi.tilebox(), reduce_data,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept -> ReduceTuple
+                {
+                    return {fall.courant(i, j, k, dtn)};
+                });
+            }
+            Real cfl = amrex::get<0>(reduce_data.value(reduce_op));
+            ParallelDescriptor::ReduceRealMax(cfl);
+
+            const int  nsub = std::max(1, static_cast<int>(std::ceil(cfl/max_cfl)));
+            const Real dts  = dtn/nsub;
+
+            for (int n = 0; n < nsub; ++n) {
+                if (n > 0) { qp_sed.FillBoundary(m_geom.periodicity()); }
+
+                m_tiles.for_each([&] (int box_no, const Box& tbx)
+                {
+                    const KesslerRainFall fall = rain_fall(box_no);
+                    const int klo = tbx.smallEnd(2);
+                    const int khi = tbx.bigEnd(2);
+                    ParallelFor(makeSlab(tbx, 2, klo), [=] AMREX_GPU_DEVICE (int i, int j, int) noexcept
+                    {
+                        fall(i, j, klo, khi, 1, dts);
+                    });
+                });
+            }
+        }
 
-            ParallelFor(box3d, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
+        // Expose for GPU
+        Real d_fac_cond = m_fac_cond;
+        const bool split_columns = m_split_columns;
+
+        m_tiles.for_each([&] (int box_no, const Box& tbx)
+        {
+            auto qv_array    = mic_fab_vars[MicVar_Kess::qv]->array(box_no);
+            auto qc_array    = mic_fab_vars[MicVar_Kess::qcl]->array(box_no);
+            auto qt_array    = mic_fab_vars[MicVar_Kess::qt]->array(box_no);
+            auto tabs_array  = mic_fab_vars[MicVar_Kess::tabs]->array(box_no);
+            auto pres_array  = mic_fab_vars[MicVar_Kess::pres]->array(box_no);
+            auto theta_array = mic_fab_vars[MicVar_Kess::theta]->array(box_no);
+            auto rho_array   = mic_fab_vars[MicVar_Kess::rho]->array(box_no);
+            auto qp_array    = mic_fab_vars[MicVar_Kess::qp]->array(box_no);
+
+            auto qp_sed_array = qp_sed.const_array(box_no);
+
+            const KesslerRainFall fall = rain_fall(box_no);
+
+            const int klo = tbx.smallEnd(2);
+            const int khi = tbx.bigEnd(2);
+
+            // A column without cloud water or rain that is subsaturated everywhere
+            // is left unchanged by the sedimentation and by all of the sources
+            // below, so only the other columns are visited. When the columns are
+            // split the rain has already fallen, possibly in from the box above.
+            ActiveColumns active;
+            active.define(makeSlab(tbx, 2, klo), [=] AMREX_GPU_DEVICE (int i, int j) noexcept
             {
-                // Jacobian determinant
-                Real dJinv = (dJ_array) ? 1.0/dJ_array(i,j,k) : 1.0;
+                for (int k = klo; k <= khi; ++k) {
+                    if (qc_array(i,j,k) != 0.0 || qp_array(i,j,k) != 0.0 || qp_sed_array(i,j,k) != 0.0 ||
+                        qv_array(i,j,k) < 0.0) {
+                        return true;
+                    }
+                    Real qsat;
+                    erf_qsatw(tabs_array(i,j,k), pres_array(i,j,k), qsat);
+                    if (qv_array(i,j,k) > qsat) {
+                        return true;
+                    }
+                }
+                return false;
+            });
 
-                qv_array(i,j,k) = std::max(0.0, qv_array(i,j,k));
-                qc_array(i,j,k) = std::max(0.0, qc_array(i,j,k));
-                qp_array(i,j,k) = std::max(0.0, qp_array(i,j,k));
+            // One thread per active column, each with its own number of substeps
+            if (!split_columns) {
+                active.ParallelFor([=] AMREX_GPU_DEVICE (int i, int j) noexcept
+                {
+                    Real cfl = 0.0;
+                    for (int k = klo; k <= khi; ++k) {
+                        cfl = std::max(cfl, fall.courant(i, j, k, dtn));
+                    }
+                    const int nsub = std::max(1, static_cast<int>(std::ceil(cfl/max_cfl)));
+                    fall(i, j, klo, khi, nsub, dtn/nsub);
+                });
+            }
 
-                //------- Autoconversion/accretion
-                Real qcc, auto_r, accrr;
-                Real dq_clwater_to_rain, dq_rain_to_vapor, dq_clwater_to_vapor, dq_vapor_to_clwater, qsat;
+            active.ParallelFor([=] AMREX_GPU_DEVICE (int i, int j) noexcept
+            {
+                for (int k = klo; k <= khi; ++k) {
+                    // Change of the rain from the sedimentation
+                    Real dq_sed = qp_sed_array(i,j,k) - qp_array(i,j,k);
+                    if(std::fabs(dq_sed) < 1e-14) dq_sed = 0.0;
 
-                Real pressure = pres_array(i,j,k);
-                erf_qsatw(tabs_array(i,j,k), pressure, qsat);
+                    qv_array(i,j,k) = std::max(0.0, qv_array(i,j,k));
+                    qc_array(i,j,k) = std::max(0.0, qc_array(i,j,k));
+                    qp_array(i,j,k) = std::max(0.0, qp_array(i,j,k));
 
-                // If there is precipitating water (i.e. rain), and the cell is not saturated
-                // then the rain water can evaporate leading to extraction of latent heat, hence
-                // reducing temperature and creating negative buoyancy
+                    //------- Autoconversion/accretion
+                    Real qcc, auto_r, accrr;
+                    Real dq_clwater_to_rain, dq_rain_to_vapor, dq_clwater_to_vapor, dq_vapor_to_clwater, qsat;
 
-                dq_clwater_to_rain  = 0.0;
-                dq_rain_to_vapor    = 0.0;
-                dq_vapor_to_clwater = 0.0;
-                dq_clwater_to_vapor = 0.0;
+                    Real pressure = pres_array(i,j,k);
+                    erf_qsatw(tabs_array(i,j,k), pressure, qsat);
 
-                Real fac = qsat*4093.0*L_v/(Cp_d*std::pow(tabs_array(i,j,k)-36.0,2));
-                //Real fac = qsat*L_v*L_v/(Cp_d*R_v*tabs_array(i,j,k)*tabs_array(i,j,k));
+                    // If there is precipitating water (i.e. rain), and the cell is not saturated
+                    // then the rain water can evaporate leading to extraction of latent heat, hence
+                    // reducing temperature and creating negative buoyancy
 
-                // If water vapor content exceeds saturation value, then vapor condenses to water and latent heat is released, increasing temperature
-                if (qv_array(i,j,k) > qsat) {
-                    dq_vapor_to_clwater = std::min(qv_array(i,j,k), (qv_array(i,j,k)-qsat)/(1.0 + fac));
-                }
+                    dq_clwater_to_rain  = 0.0;
+                    dq_rain_to_vapor    = 0.0;
+                    dq_vapor_to_clwater = 0.0;
+                    dq_clwater_to_vapor = 0.0;
 
-                // If water vapor is less than the saturated value, then the cloud water can evaporate,
-                // leading to evaporative cooling and reducing temperature
-                if (qv_array(i,j,k) < qsat && qc_array(i,j,k) > 0.0) {
-                    dq_clwater_to_vapor = std::min(qc_array(i,j,k), (qsat - qv_array(i,j,k))/(1.0 + fac));
-                }
+                    Real fac = qsat*4093.0*L_v/(Cp_d*std::pow(tabs_array(i,j,k)-36.0,2));
+                    //Real fac = qsat*L_v*L_v/(Cp_d*R_v*tabs_array(i,j,k)*tabs_array(i,j,k));
 
-                if (qp_array(i,j,k) > 0.0 && qv_array(i,j,k) < qsat) {
-                    Real C = 1.6 + 124.9*std::pow(0.001*rho_array(i,j,k)*qp_array(i,j,k),0.2046);
-                    dq_rain_to_vapor = 1.0/(0.001*rho_array(i,j,k))*(1.0 - qv_array(i,j,k)/qsat)*C*std::pow(0.001*rho_array(i,j,k)*qp_array(i,j,k),0.525)/
-                        (5.4e5 + 2.55e6/(pressure*qsat))*dtn;
-                    // The negative sign is to make this variable (vapor formed from evaporation)
-                    // a positive quantity (as qv/qs < 1)
-                    dq_rain_to_vapor = std::min({qp_array(i,j,k), dq_rain_to_vapor});
+                    // If water vapor content exceeds saturation value, then vapor condenses to water and latent heat is released, increasing temperature
+                    if (qv_array(i,j,k) > qsat) {
+                        dq_vapor_to_clwater = std::min(qv_array(i,j,k), (qv_array(i,j,k)-qsat)/(1.0 + fac));
+                    }
 
-                    // Removing latent heat due to evaporation from rain water to water vapor, reduces the (potential) temperature
-                }
+                    // If water vapor is less than the saturated value, then the cloud water can evaporate,
+                    // leading to evaporative cooling and reducing temperature
+                    if (qv_array(i,j,k) < qsat && qc_array(i,j,k) > 0.0) {
+                        dq_clwater_to_vapor = std::min(qc_array(i,j,k), (qsat - qv_array(i,j,k))/(1.0 + fac));
+                    }
 
-                // If there is cloud water present then do accretion and autoconversion to rain
-                if (qc_array(i,j,k) > 0.0) {
-                    qcc = qc_array(i,j,k);
+                    if (qp_array(i,j,k) > 0.0 && qv_array(i,j,k) < qsat) {
+                        Real C = 1.6 + 124.9*std::pow(0.001*rho_array(i,j,k)*qp_array(i,j,k),0.2046);
+                        dq_rain_to_vapor = 1.0/(0.001*rho_array(i,j,k))*(1.0 - qv_array(i,j,k)/qsat)*C*std::pow(0.001*rho_array(i,j,k)*qp_array(i,j,k),0.525)/
+                            (5.4e5 + 2.55e6/(pressure*qsat))*dtn;
+                        // The negative sign is to make this variable (vapor formed from evaporation)
+                        // a positive quantity (as qv/qs < 1)
+                        dq_rain_to_vapor = std::min({qp_array(i,j,k), dq_rain_to_vapor});
 
-                    auto_r = 0.0;
-                    if (qcc > qcw0) {
-                        auto_r = alphaelq;
+                        // Removing latent heat due to evaporation from rain water to water vapor, reduces the (potential) temperature
                     }
 
-                    accrr = 0.0;
-                    accrr = 2.2 * std::pow(qp_array(i,j,k) , 0.875);
-                    dq_clwater_to_rain = dtn *(accrr*qcc + auto_r*(qcc - qcw0));
+                    // If there is cloud water present then do accretion and autoconversion to rain
+                    if (qc_array(i,j,k) > 0.0) {
+                        qcc = qc_array(i,j,k);
 
-                    // If the amount of change is more than the amount of qc present, then dq = qc
-                    dq_clwater_to_rain = std::min(dq_clwater_to_rain, qc_array(i,j,k));
-                }
+                        auto_r = 0.0;
+                        if (qcc > qcw0) {
+                            auto_r = alphaelq;
+                        }
 
-                if(std::fabs(fz_array(i,j,k+1)) < 1e-14) fz_array(i,j,k+1) = 0.0;
-                if(std::fabs(fz_array(i,j,k  )) < 1e-14) fz_array(i,j,k  ) = 0.0;
-                Real dq_sed = dtn * dJinv * (1.0/rho_array(i,j,k)) * (fz_array(i,j,k+1) - fz_array(i,j,k))/dz;
-                if(std::fabs(dq_sed) < 1e-14) dq_sed = 0.0;
+                        accrr = 0.0;
+                        accrr = 2.2 * std::pow(qp_array(i,j,k) , 0.875);
+                        dq_clwater_to_rain = dtn *(accrr*qcc + auto_r*(qcc - qcw0));
 
-                qv_array(i,j,k) += -dq_vapor_to_clwater + dq_clwater_to_vapor + dq_rain_to_vapor;
-                qc_array(i,j,k) +=  dq_vapor_to_clwater - dq_clwater_to_vapor - dq_clwater_to_rain;
-                qp_array(i,j,k) +=  dq_sed + dq_clwater_to_rain - dq_rain_to_vapor;
+                        // If the amount of change is more than the amount of qc present, then dq = qc
+                        dq_clwater_to_rain = std::min(dq_clwater_to_rain, qc_array(i,j,k));
+                    }
 
-                Real theta_over_T = theta_array(i,j,k)/tabs_array(i,j,k);
-                theta_array(i,j,k) += theta_over_T * d_fac_cond * (dq_vapor_to_clwater - dq_clwater_to_vapor - dq_rain_to_vapor);
+                    qv_array(i,j,k) += -dq_vapor_to_clwater + dq_clwater_to_vapor + dq_rain_to_vapor;
+                    qc_array(i,j,k) +=  dq_vapor_to_clwater - dq_clwater_to_vapor - dq_clwater_to_rain;
+                    qp_array(i,j,k) +=  dq_sed + dq_clwater_to_rain - dq_rain_to_vapor;
 
-                qv_array(i,j,k) = std::max(0.0, qv_array(i,j,k));
-                qc_array(i,j,k) = std::max(0.0, qc_array(i,j,k));
-                qp_array(i,j,k) = std::max(0.0, qp_array(i,j,k));
+                    Real theta_over_T = theta_array(i,j,k)/tabs_array(i,j,k);
+                    theta_array(i,j,k) += theta_over_T * d_fac_cond * (dq_vapor_to_clwater - dq_clwater_to_vapor - dq_rain_to_vapor);
 
-                qt_array(i,j,k) = qv_array(i,j,k) + qc_array(i,j,k);
+                    qv_array(i,j,k) = std::max(0.0, qv_array(i,j,k));
+                    qc_array(i,j,k) = std::max(0.0, qc_array(i,j,k));
+                    qp_array(i,j,k) = std::max(0.0, qp_array(i,j,k));
+
+                    qt_array(i,j,k) = qv_array(i,j,k) + qc_array(i,j,k);
+                }
             });
+        });
+
+        if (m_verbose > 0) {
+            Real mass_after = rain_mass();
+            Print() << std::setprecision(15) << "Kessler: rain mass " << mass_before << " kg before and "
+                    << mass_after << " kg after the sedimentation" << std::endl;
         }
     }
 
     if (solverChoice.moisture_type == MoistureType::Kessler_NoRain){
 
         // get the temperature, dentisy, theta, qt and qc from input
-        for ( MFIter mfi(*tabs,TilingIfNotGPU()); mfi.isValid(); ++mfi) {
-            auto qv_array    = mic_fab_vars[MicVar_Kess::qv]->array(mfi);
-            auto qc_array    = mic_fab_vars[MicVar_Kess::qcl]->array(mfi);
-            auto qt_array    = mic_fab_vars[MicVar_Kess::qt]->array(mfi);
-            auto tabs_array  = mic_fab_vars[MicVar_Kess::tabs]->array(mfi);
-            auto theta_array = mic_fab_vars[MicVar_Kess::theta]->array(mfi);
-            auto pres_array  = mic_fab_vars[MicVar_Kess::pres]->array(mfi);
+        m_tiles.for_each([&] (int box_no, const Box& tbx)
+        {
+            auto qv_array    = mic_fab_vars[MicVar_Kess::qv]->array(box_no);
+            auto qc_array    = mic_fab_vars[MicVar_Kess::qcl]->array(box_no);
+            auto qt_array    = mic_fab_vars[MicVar_Kess::qt]->array(box_no);
+            auto tabs_array  = mic_fab_vars[MicVar_Kess::tabs]->array(box_no);
+            auto theta_array = mic_fab_vars[MicVar_Kess::theta]->array(box_no);
+            auto pres_array  = mic_fab_vars[MicVar_Kess::pres]->array(box_no);
 
-            const auto& box3d = mfi.tilebox();
+            const auto& box3d = tbx;
 
             // Expose for GPU
             Real d_fac_cond = m_fac_cond;
@@ -234,6 +419,6 @@ void Kessler::AdvanceKessler (const SolverChoice &solverChoice)
 
                 qt_array(i,j,k) = qv_array(i,j,k) + qc_array(i,j,k);
             });
-        }
+        });
     }
 }
@@ -39,3 +39,24 @@ void Kessler::Copy_Micro_to_State (MultiFab& cons)
     cons.FillBoundary(m_geom.periodicity());
 }
 
+
+/**
+ * Orders the tiles used by the microphysics kernels by decreasing cost. Most of the
+ * work is done in cells with cloud water or rain, so the cost of a tile is estimated
+ * by the number of such cells at the start of the step.
+ */
+void Kessler::Sort_Tiles ()
+{
+    m_tiles.sort_by_cost([&] (int box_no, const Box& tbx) -> Real
+    {
+        auto qc_arr = mic_fab_vars[MicVar_Kess::qcl]->const_array(box_no);
+        auto qp_arr = mic_fab_vars[MicVar_Kess::qp]->const_array(box_no);
+
+        Real ncells = 0.0;
+        LoopOnCpu(tbx, [&] (int i, int j, int k) noexcept
+        {
+            if (qc_arr(i,j,k) > 0.0 || qp_arr(i,j,k) > 0.0) { ncells += 1.0; }
+        });
+        return ncells;
+    });
+}
@@ -0,0 +1,101 @@
+#include "SAM.H"
+#include "SAM_Kernels.H"
+#include "TileNoZ.H"
+#include "ActiveColumns.H"
+
+using namespace amrex;
+
+/**
+ * Cloud, IceFall, Precip and PrecipFall fused into a single kernel over the columns.
+ *
+ * Each column goes through the same sequence as the separate sweeps: the
+ * saturation adjustment (including the ghost cell below and above, as in Cloud),
+ * then one upward sweep that sediments the cloud ice and applies the
+ * autoconversion, accretion and evaporation, then the (substepped) sedimentation
+ * of the precipitation. The flux through the lower face of a cell is carried from
+ * one level to the next, so no flux MultiFabs are needed and the column stays in
+ * cache between the processes.
+ *
+ * Columns without condensate or precipitation that are subsaturated everywhere
+ * are left unchanged by all of the processes (up to the recomputation of the
+ * pressure and theta from the unchanged temperature), so the kernel only runs
+ * over the compacted list of the other columns.
+ */
+void
+SAM::Column (const SolverChoice& sc)
+{
+    const bool do_ice    = !(sc.moisture_type == MoistureType::SAM_NoIce ||
+                             sc.moisture_type == MoistureType::SAM_NoPrecip_NoIce);
+    const bool do_precip =  (sc.moisture_type != MoistureType::SAM_NoPrecip_NoIce);
+    const Real max_cfl   = sc.sed_max_cfl;
+
+    m_tiles.for_each([&] (int box_no, const Box& tbx)
+    {
+        const SAMCloud            cloud       = Cloud_Kernel(sc, box_no);
+        const SAMIceFallFlux      ice_flux    = IceFall_Flux_Kernel(box_no);
+        const SAMIceFallUpdate    ice_update  = IceFall_Update_Kernel(box_no);
+        const SAMPrecip           precip      = Precip_Kernel(sc, box_no);
+        const SAMPrecipFallFlux   fall_flux   = PrecipFall_Flux_Kernel(sc, box_no);
+        const SAMPrecipFallUpdate fall_update = PrecipFall_Update_Kernel(sc, box_no);
+
+        const int klo = tbx.smallEnd(2);
+        const int khi = tbx.bigEnd(2);
+
+        auto qt_array   = mic_fab_vars[MicVar::qt]->const_array(box_no);
+        auto qn_array   = mic_fab_vars[MicVar::qn]->const_array(box_no);
+        auto qcl_array  = mic_fab_vars[MicVar::qcl]->const_array(box_no);
+        auto qci_array  = mic_fab_vars[MicVar::qci]->const_array(box_no);
+        auto qp_array   = mic_fab_vars[MicVar::qp]->const_array(box_no);
+        auto qpr_array  = mic_fab_vars[MicVar::qpr]->const_array(box_no);
+        auto qps_array  = mic_fab_vars[MicVar::qps]->const_array(box_no);
+        auto qpg_array  = mic_fab_vars[MicVar::qpg]->const_array(box_no);
+        auto tabs_array = mic_fab_vars[MicVar::tabs]->const_array(box_no);
+        auto pres_array = mic_fab_vars[MicVar::pres]->const_array(box_no);
+
+        // One thread per active column
+        ActiveColumns active;
+        active.define(makeSlab(tbx, 2, klo), [=] AMREX_GPU_DEVICE (int i, int j) noexcept
+        {
+            for (int k = klo-1; k <= khi+1; ++k) {
+                if (qn_array(i,j,k)  != 0.0 || qcl_array(i,j,k) != 0.0 || qci_array(i,j,k) != 0.0 ||
+                    qp_array(i,j,k)  != 0.0 || qpr_array(i,j,k) != 0.0 ||
+                    qps_array(i,j,k) != 0.0 || qpg_array(i,j,k) != 0.0) {
+                    return true;
+                }
+                Real qsatw, qsati;
+                erf_qsatw(tabs_array(i,j,k), pres_array(i,j,k), qsatw);
+                erf_qsati(tabs_array(i,j,k), pres_array(i,j,k), qsati);
+                if (qt_array(i,j,k) > std::min(qsatw, qsati)) {
+                    return true;
+                }
+            }
+            return false;
+        });
+
+        active.ParallelFor([=] AMREX_GPU_DEVICE (int i, int j) noexcept
+        {
+            for (int k = klo-1; k <= khi+1; ++k) {
+                cloud(i, j, k);
+            }
+
+            // The flux through the upper face of cell k is computed before cell k
+            // is updated, and cell k+1 is only updated in the next iteration, so
+            // both fluxes of a cell see the state before the sedimentation
+            Real fz_lo = (do_ice) ? ice_flux(i, j, klo) : 0.0;
+            for (int k = klo; k <= khi; ++k) {
+                if (do_ice) {
+                    const Real fz_hi = ice_flux(i, j, k+1);
+                    ice_update(i, j, k, fz_lo, fz_hi);
+                    fz_lo = fz_hi;
+                }
+                if (do_precip) {
+                    precip(i, j, k);
+                }
+            }
+
+            if (do_precip) {
+                SAMPrecipFallColumn(i, j, klo, khi, max_cfl, fall_flux, fall_update);
+            }
+        });
+    });
+}
@@ -1,5 +1,6 @@
 #include <AMReX_ParReduce.H>
 #include "SAM.H"
+#include "SAM_Kernels.H"
 #include "TileNoZ.H"
 
 using namespace amrex;
@@ -13,20 +14,7 @@ void SAM::IceFall (const SolverChoice& sc) {
        sc.moisture_type == MoistureType::SAM_NoPrecip_NoIce)
       return;
 
-    Real dz   = m_geom.CellSize(2);
-    Real dtn  = dt;
-    Real coef = dtn/dz;
-
-    auto domain = m_geom.Domain();
-    int k_lo = domain.smallEnd(2);
-    int k_hi = domain.bigEnd(2);
-
     auto qcl   = mic_fab_vars[MicVar::qcl];
-    auto qci   = mic_fab_vars[MicVar::qci];
-    auto qn    = mic_fab_vars[MicVar::qn];
-    auto qt    = mic_fab_vars[MicVar::qt];
-    auto rho   = mic_fab_vars[MicVar::rho];
-    auto tabs  = mic_fab_vars[MicVar::tabs];
 
     MultiFab fz;
     IntVect  ng = qcl->nGrowVect();
@@ -35,69 +23,73 @@ void SAM::IceFall (const SolverChoice& sc) {
     fz.define(convert(ba, IntVect(0,0,1)), dm, 1, ng);
     fz.setVal(0.);
 
-    for (MFIter mfi(fz, TileNoZ()); mfi.isValid(); ++mfi) {
-        auto qci_array = qci->array(mfi);
-        auto rho_array = rho->array(mfi);
-        auto fz_array  = fz.array(mfi);
+    m_tiles.for_each([&] (int box_no, const Box& tbx)
+    {
+        const SAMIceFallFlux flux = IceFall_Flux_Kernel(box_no);
+
+        auto fz_array  = fz.array(box_no);
 
-        const auto& box3d  = mfi.tilebox();
+        const auto& box3d  = amrex::surroundingNodes(tbx, 2);
 
         ParallelFor(box3d, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
         {
-            Real rho_avg, qci_avg;
-            if (k==k_lo) {
-                rho_avg = rho_array(i,j,k);
-                qci_avg = qci_array(i,j,k);
-            } else if (k==k_hi+1) {
-                rho_avg = rho_array(i,j,k-1);
-                qci_avg = qci_array(i,j,k-1);
-            } else {
-                rho_avg = 0.5*(rho_array(i,j,k-1) + rho_array(i,j,k));
-                qci_avg = 0.5*(qci_array(i,j,k-1) + qci_array(i,j,k));
-            }
-            Real vt_ice = min( 0.4 , 8.66 * pow( (max(0.,qci_avg)+1.e-10) , 0.24) );
-
-            // NOTE: Fz is the sedimentation flux from the advective operator.
-            //       In the terrain-following coordinate system, the z-deriv in
-            //       the divergence uses the normal velocity (Omega). However,
-            //       there are no u/v components to the sedimentation velocity.
-            //       Therefore, we simply end up with a division by detJ when
-            //       evaluating the source term: dJinv * (flux_hi - flux_lo) * dzinv.
-            fz_array(i,j,k) = rho_avg*vt_ice*qci_avg;
+            fz_array(i,j,k) = flux(i,j,k);
         });
-    }
+    });
 
-    for (MFIter mfi(*qci, TileNoZ()); mfi.isValid(); ++mfi) {
-        auto qci_array   = qci->array(mfi);
-        auto qn_array    = qn->array(mfi);
-        auto qt_array    = qt->array(mfi);
-        auto rho_array   = rho->array(mfi);
-        auto fz_array    = fz.array(mfi);
+    m_tiles.for_each([&] (int box_no, const Box& tbx)
+    {
+        const SAMIceFallUpdate update = IceFall_Update_Kernel(box_no);
 
-        const auto dJ_array = (m_detJ_cc) ? m_detJ_cc->const_array(mfi) : Array4<const Real>{};
+        auto fz_array    = fz.array(box_no);
 
-        const auto& box3d  = mfi.tilebox();
+        const auto& box3d  = tbx;
 
         ParallelFor(box3d, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept
         {
-            // Jacobian determinant
-            Real dJinv = (dJ_array) ? 1.0/dJ_array(i,j,k) : 1.0;
-
-            //==================================================
-            // Cloud ice sedimentation (A32)
-            //==================================================
-            Real dqi  = dJinv * (1.0/rho_array(i,j,k)) * ( fz_array(i,j,k+1) - fz_array(i,j,k) ) * coef;
-            dqi = std::max(-qci_array(i,j,k), dqi);
-
-            // Add this increment to both non-precipitating and total water.
-            qci_array(i,j,k) += dqi;
-             qn_array(i,j,k) += dqi;
-             qt_array(i,j,k) += dqi;
-
-            // NOTE: Sedimentation does not affect the potential temperature,
-            //       but it does affect the liquid/ice static energy.
-            //       No source to Theta occurs here.
+            update(i, j, k, fz_array(i,j,k), fz_array(i,j,k+1));
         });
-    }
+    });
 }
 
+/**
+ * Cloud ice flux kernel on box box_no
+ */
+SAMIceFallFlux
+SAM::IceFall_Flux_Kernel (int box_no)
+{
+    auto domain = m_geom.Domain();
+
+    SAMIceFallFlux flux;
+
+    flux.qci_array = mic_fab_vars[MicVar::qci]->array(box_no);
+    flux.rho_array = mic_fab_vars[MicVar::rho]->array(box_no);
+
+    flux.k_lo = domain.smallEnd(2);
+    flux.k_hi = domain.bigEnd(2);
+
+    return flux;
+}
+
+/**
+ * Cloud ice update kernel on box box_no
+ */
+SAMIceFallUpdate
+SAM::IceFall_Update_Kernel (int box_no)
+{
+    Real dz   = m_geom.CellSize(2);
+    Real dtn  = dt;
+
+    SAMIceFallUpdate update;
+
+    update.qci_array = mic_fab_vars[MicVar::qci]->array(box_no);
+    update.qn_array  = mic_fab_vars[MicVar::qn]->array(box_no);
+    update.qt_array  = mic_fab_vars[MicVar::qt]->array(box_no);
+    update.rho_array = mic_fab_vars[MicVar::rho]->array(box_no);
+
+    update.dJ_array = (m_detJ_cc) ? m_detJ_cc->const_array(box_no) : Array4<const Real>{};
+
+    update.coef = dtn/dz;
+
+    return update;
+}
@@ -37,13 +37,29 @@ SAM::Init (const MultiFab& cons_in,
     MicVarMap = {MicVar::qt, MicVar::qv , MicVar::qcl, MicVar::qci,
                  MicVar::qp, MicVar::qpr, MicVar::qps, MicVar::qpg, MicVar::rain_accum, MicVar::snow_accum, MicVar::graup_accum};
 
-    // initialize microphysics variables
+    // initialize microphysics variables; the density is not allocated since it
+    // is a view of the conserved state (see Copy_State_to_Micro)
     for (auto ivar = 0; ivar < MicVar::NumVars; ++ivar) {
+        if (ivar == MicVar::rho) continue;
         mic_fab_vars[ivar] = std::make_shared<MultiFab>(cons_in.boxArray(), cons_in.DistributionMap(),
                                                         1, cons_in.nGrowVect());
         mic_fab_vars[ivar]->setVal(0.);
     }
 
+    // Init is called again on regrid, so drop any view of the old state right away
+    mic_fab_vars[MicVar::rho] = std::make_shared<MultiFab>(cons_in, make_alias, Rho_comp, 1);
+    m_tiles.define(*mic_fab_vars[MicVar::tabs]);
+
+    // The coefficient tables below span the column of one box, and the processes
+    //    (the sedimentation in particular) run down whole columns within a box
+    const Box& domain = geom.Domain();
+    const BoxArray& ba = cons_in.boxArray();
+    for (int i = 0; i < ba.size(); ++i) {
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(ba[i].smallEnd(2) == domain.smallEnd(2) &&
+                                         ba[i].bigEnd(2)   == domain.bigEnd(2),
+                                         "SAM microphysics needs every box to span the whole column; set amr.max_grid_size_z");
+    }
+
     // Set class data members
     for ( MFIter mfi(cons_in, TileNoZ()); mfi.isValid(); ++mfi) {
         const auto& box3d = mfi.tilebox();
@@ -87,7 +103,15 @@ SAM::Init (const MultiFab& cons_in,
 void
 SAM::Copy_State_to_Micro (const MultiFab& cons_in)
 {
-    // Get the temperature, density, theta, qt and qp from input
+    // The density is used as is, so alias it rather than copying it. The alias
+    // is rebuilt on every call since the state MultiFabs are swapped between
+    // steps and replaced on regrid. The other variables cannot be views of the
+    // state: the state holds rho*theta and rho*q, the microphysics updates theta
+    // and the mixing ratios (qv, qcl, qci, qp, qpr, qps and qpg) in place, and
+    // tabs and pres are not part of the state.
+    mic_fab_vars[MicVar::rho] = std::make_shared<MultiFab>(cons_in, make_alias, Rho_comp, 1);
+
+    // Get the temperature, theta, qt and qp from input
     for ( MFIter mfi(cons_in); mfi.isValid(); ++mfi) {
         const auto& box3d = mfi.growntilebox();
 
@@ -106,15 +130,13 @@ SAM::Copy_State_to_Micro (const MultiFab& cons_in)
         auto qpg_array   = mic_fab_vars[MicVar::qpg]->array(mfi);
         auto qp_array    = mic_fab_vars[MicVar::qp]->array(mfi);
 
-        auto rho_array   = mic_fab_vars[MicVar::rho]->array(mfi);
         auto theta_array = mic_fab_vars[MicVar::theta]->array(mfi);
         auto tabs_array  = mic_fab_vars[MicVar::tabs]->array(mfi);
         auto pres_array  = mic_fab_vars[MicVar::pres]->array(mfi);
 
-        // Get pressure, theta, temperature, density, and qt, qp
+        // Get pressure, theta, temperature, and qt, qp
         ParallelFor( box3d, [=] AMREX_GPU_DEVICE (int i, int j, int k)
         {
-            rho_array(i,j,k)   = states_array(i,j,k,Rho_comp);
             theta_array(i,j,k) = states_array(i,j,k,RhoTheta_comp)/states_array(i,j,k,Rho_comp);
 
             qv_array(i,j,k)    = std::max(0.0,states_array(i,j,k,RhoQ1_comp)/states_array(i,j,k,Rho_comp));
@@ -51,3 +51,25 @@ SAM::Copy_Micro_to_State (MultiFab& cons)
 }
 
 
+
+/**
+ * Orders the tiles used by the microphysics kernels by decreasing cost. Only the
+ * cells that hold condensate or precipitation do real work, so the cost of a tile
+ * is estimated by the number of such cells at the start of the step.
+ */
+void
+SAM::Sort_Tiles ()
+{
+    m_tiles.sort_by_cost([&] (int box_no, const Box& tbx) -> Real
+    {
+        auto qn_arr = mic_fab_vars[MicVar::qn]->const_array(box_no);
+        auto qp_arr = mic_fab_vars[MicVar::qp]->const_array(box_no);
+
+        Real ncells = 0.0;
+        LoopOnCpu(tbx, [&] (int i, int j, int k) noexcept
+        {
+            if (qn_arr(i,j,k) > 0.0 || qp_arr(i,j,k) > 0.0) { ncells += 1.0; }
+        });
+        return ncells;
+    });
+}
@@ -0,0 +1,461 @@
+#include <SuperDropletPC.H>
+
+#ifdef ERF_USE_PARTICLES
+
+#include <algorithm>
+
+#include <AMReX_ParmParse.H>
+#include <AMReX_ParticleInterpolators.H>
+#include <EOS.H>
+#include <Microphysics_Utils.H>
+
+using namespace amrex;
+
+/*! Constructor */
+SuperDropletPC::SuperDropletPC ( const Geometry&            a_geom,
+                                 const DistributionMapping& a_dmap,
+                                 const BoxArray&            a_ba,
+                                 const std::string&         a_name )
+    : ERFPC(a_geom, a_dmap, a_ba, a_name)
+{
+    BL_PROFILE("SuperDropletPC::SuperDropletPC()");
+
+    // multiplicity, radius and dry radius
+    for (int n = ERFParticlesRealIdxSoA::ncomps; n < SuperDropletsRealIdxSoA::ncomps; ++n) {
+        AddRealComp(true);
+    }
+
+    // the base class constructor only reads the inputs of ERFPC
+    readInputs();
+}
+
+/*! Read inputs from file */
+void SuperDropletPC::readInputs ()
+{
+    BL_PROFILE("SuperDropletPC::readInputs");
+
+    ERFPC::readInputs();
+
+    ParmParse pp(m_name);
+
+    // Aerosol on which the droplets grow: lognormal distribution of the dry radius
+    m_aerosol_number = 1.0e8;
+    pp.query("aerosol_number", m_aerosol_number);
+    m_aerosol_radius = 0.04e-6;
+    pp.query("aerosol_radius", m_aerosol_radius);
+    m_aerosol_sigma = 1.4;
+    pp.query("aerosol_sigma", m_aerosol_sigma);
+    AMREX_ALWAYS_ASSERT(m_aerosol_number > 0.0 && m_aerosol_radius > 0.0 && m_aerosol_sigma >= 1.0);
+}
+
+/*! Draw the dry radii of the particles placed by ERFPC::InitializeParticles from
+ *  the aerosol distribution; each particle stands for an equal share of the
+ *  aerosol of its cell. The droplets start at the size of their nucleus. */
+void SuperDropletPC::initializeDroplets (const MultiFab* a_detJ)
+{
+    BL_PROFILE("SuperDropletPC::initializeDroplets");
+
+    const int lev = 0;
+    const auto& geom = Geom(lev);
+    const auto plo = geom.ProbLoArray();
+    const auto dx  = geom.CellSizeArray();
+    const auto dxi = geom.InvCellSizeArray();
+    const Box domain = geom.Domain();
+
+    const Real n_per_particle = m_aerosol_number * dx[0]*dx[1]*dx[2] / static_cast<Real>(m_ppc_init);
+    const Real log_r = std::log(m_aerosol_radius);
+    const Real log_s = std::log(m_aerosol_sigma);
+
+    for (ParIterType pti(*this, lev); pti.isValid(); ++pti)
+    {
+        const int grid = pti.index();
+        const Box& bx  = pti.tilebox();
+        auto& ptile = ParticlesAt(lev, pti);
+        auto& aos = ptile.GetArrayOfStructs();
+        auto& soa = ptile.GetStructOfArrays();
+        const int np = aos.numParticles();
+        auto* pstruct = aos().data();
+
+        auto* mass_ptr = soa.GetRealData(ERFParticlesRealIdxSoA::mass).data();
+        auto* xi_ptr   = soa.GetRealData(SuperDropletsRealIdxSoA::multiplicity).data();
+        auto* rad_ptr  = soa.GetRealData(SuperDropletsRealIdxSoA::radius).data();
+        auto* rdry_ptr = soa.GetRealData(SuperDropletsRealIdxSoA::dry_radius).data();
+
+        const auto dJ_arr = (a_detJ) ? (*a_detJ)[grid].const_array() : Array4<const Real>{};
+
+        ParallelForRNG(np, [=] AMREX_GPU_DEVICE (int n, const RandomEngine& engine) noexcept
+        {
+            const auto& p = pstruct[n];
+            IntVect iv = ERFParticlesAssignor{}(p, plo, dxi, domain);
+            iv.max(bx.smallEnd());
+            iv.min(bx.bigEnd());
+
+            const Real r_dry = std::exp(RandomNormal(log_r, log_s, engine));
+            const Real xi    = n_per_particle * ((dJ_arr) ? dJ_arr(iv) : 1.0);
+
+            xi_ptr[n]   = std::max(1.0, std::floor(xi + 0.5));
+            rdry_ptr[n] = r_dry;
+            rad_ptr[n]  = r_dry;
+            mass_ptr[n] = SuperDroplets_K::droplet_mass(r_dry);
+        });
+    }
+}
+
+/*! Fall at the terminal velocity; droplets that reach the ground are added to
+ *  rain_accum (mm) and removed */
+void SuperDropletPC::Sediment ( Real            a_dt,
+                                const MultiFab* a_z_height,
+                                MultiFab&       a_rain_accum )
+{
+    BL_PROFILE("SuperDropletPC::Sediment()");
+
+    const int lev = 0;
+    const auto& geom = Geom(lev);
+    const auto plo = geom.ProbLoArray();
+    const auto dx  = geom.CellSizeArray();
+    const auto dxi = geom.InvCellSizeArray();
+    const Box domain = geom.Domain();
+    const int klo = domain.smallEnd(2);
+
+    // mass per unit area (kg/m^2) to accumulated rain (mm)
+    const Real rain_fac = 1000.0 / (rhor*dx[0]*dx[1]);
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (ParIterType pti(*this, lev); pti.isValid(); ++pti)
+    {
+        const int grid = pti.index();
+        const Box& bx  = pti.tilebox();
+        auto& ptile = ParticlesAt(lev, pti);
+        auto& aos = ptile.GetArrayOfStructs();
+        auto& soa = ptile.GetStructOfArrays();
+        const int np = aos.numParticles();
+        auto* pstruct = aos().data();
+
+        const auto* mass_ptr = soa.GetRealData(ERFParticlesRealIdxSoA::mass).data();
+        const auto* xi_ptr   = soa.GetRealData(SuperDropletsRealIdxSoA::multiplicity).data();
+        const auto* rad_ptr  = soa.GetRealData(SuperDropletsRealIdxSoA::radius).data();
+
+        const bool use_terrain = (a_z_height != nullptr);
+        const auto zheight = (use_terrain) ? (*a_z_height)[grid].const_array() : Array4<const Real>{};
+        auto rain_arr = a_rain_accum.array(grid);
+
+        ParallelFor(np, [=] AMREX_GPU_DEVICE (int n) noexcept
+        {
+            ParticleType& p = pstruct[n];
+            if (p.id() <= 0) { return; }
+
+            p.pos(2) -= static_cast<ParticleReal>(SuperDroplets_K::terminal_velocity(rad_ptr[n])*a_dt);
+
+            if (use_terrain) {
+                update_location_idata(p, plo, dxi, zheight);
+            } else {
+                p.idata(ERFParticlesIntIdxAoS::k) = klo + int(Math::floor((p.pos(2)-plo[2])*dxi[2]));
+            }
+
+            if (p.idata(ERFParticlesIntIdxAoS::k) < klo) {
+                IntVect iv = ERFParticlesAssignor{}(p, plo, dxi, domain);
+                const int i = amrex::min(amrex::max(iv[0], bx.smallEnd(0)), bx.bigEnd(0));
+                const int j = amrex::min(amrex::max(iv[1], bx.smallEnd(1)), bx.bigEnd(1));
+                Gpu::Atomic::AddNoRet(&rain_arr(i,j,klo), xi_ptr[n]*mass_ptr[n]*rain_fac);
+                p.id() = -1;
+            }
+        });
+    }
+}
+
+/*! Condensation/evaporation and collision-coalescence of the droplets
+ *
+ * The particles of a tile are binned by cell and one thread works on all of the
+ * super-droplets of a cell:
+ *   - each droplet grows or evaporates (down to its dry radius) against the vapor
+ *     of the cell, with the vapor updated after each super-droplet so that the
+ *     droplets of a cell cannot take more than the excess vapor between them;
+ *   - the super-droplets are then randomly paired and each pair coalesces with the
+ *     probability of the Monte Carlo scheme of Shima et al. (2009), with a
+ *     gravitational collection kernel (collision efficiency of one);
+ *   - the cloud water of the cell is set from the droplets.
+ * The latent heat of the condensed water goes into theta at constant pressure.
+ * Curvature and solute effects on the saturation at the droplet surface are
+ * neglected.
+ */
+void SuperDropletPC::CondenseAndCollide ( Real            a_dt,
+                                          const MultiFab& a_rho,
+                                          MultiFab&       a_theta,
+                                          MultiFab&       a_qv,
+                                          MultiFab&       a_qc,
+                                          const MultiFab* a_detJ,
+                                          Real            a_fac_cond )
+{
+    BL_PROFILE("SuperDropletPC::CondenseAndCollide()");
+
+    const int lev = 0;
+    const auto& geom = Geom(lev);
+    const auto plo = geom.ProbLoArray();
+    const auto dx  = geom.CellSizeArray();
+    const auto dxi = geom.InvCellSizeArray();
+    const Box domain = geom.Domain();
+    const Real dv = dx[0]*dx[1]*dx[2];
+
+    // Thermal conductivity of air (W/(m K)) and diffusivity of vapor in air (m^2/s)
+    constexpr Real K_a = 2.4e-2;
+    constexpr Real D_v = 2.21e-5;
+
+    // Cells without droplets hold no cloud water
+    a_qc.setVal(0.0);
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (ParIterType pti(*this, lev); pti.isValid(); ++pti)
+    {
+        const int grid = pti.index();
+        const Box& bx  = pti.tilebox();
+        auto& ptile = ParticlesAt(lev, pti);
+        auto& aos = ptile.GetArrayOfStructs();
+        auto& soa = ptile.GetStructOfArrays();
+        const int np = aos.numParticles();
+        auto* pstruct = aos().data();
+
+        auto* mass_ptr = soa.GetRealData(ERFParticlesRealIdxSoA::mass).data();
+        auto* xi_ptr   = soa.GetRealData(SuperDropletsRealIdxSoA::multiplicity).data();
+        auto* rad_ptr  = soa.GetRealData(SuperDropletsRealIdxSoA::radius).data();
+        auto* rdry_ptr = soa.GetRealData(SuperDropletsRealIdxSoA::dry_radius).data();
+
+        const auto rho_arr   = a_rho.const_array(grid);
+        const auto dJ_arr    = (a_detJ) ? a_detJ->const_array(grid) : Array4<const Real>{};
+        auto       theta_arr = a_theta.array(grid);
+        auto       qv_arr    = a_qv.array(grid);
+        auto       qc_arr    = a_qc.array(grid);
+
+        // Bin the particles of the tile by cell
+        DenseBins<ParticleType> bins;
+        bins.build(np, pstruct, bx,
+                   [=] AMREX_GPU_HOST_DEVICE (const ParticleType& p) noexcept -> IntVect
+                   {
+                       IntVect iv = ERFParticlesAssignor{}(p, plo, dxi, domain);
+                       iv.max(bx.smallEnd());
+                       iv.min(bx.bigEnd());
+                       return iv;
+                   });
+        auto* perm = bins.permutationPtr();
+        const auto* offsets = bins.offsetsPtr();
+
+        ParallelForRNG(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k, const RandomEngine& engine) noexcept
+        {
+            const auto c     = bx.index(IntVect(AMREX_D_DECL(i,j,k)));
+            const int  start = static_cast<int>(offsets[c]);
+            const int  stop  = static_cast<int>(offsets[c+1]);
+            if (start == stop) { return; }
+
+            const Real rho     = rho_arr(i,j,k);
+            const Real vol     = dv * ((dJ_arr) ? dJ_arr(i,j,k) : 1.0);
+            const Real air_mass = rho*vol;
+
+            //------- Condensation/evaporation
+            Real qv    = qv_arr(i,j,k);
+            Real theta = theta_arr(i,j,k);
+            const Real tabs = getTgivenRandRTh(rho, rho*theta, qv);
+            const Real pres = getPgivenRTh(rho*theta, qv);
+
+            Real qsat;
+            erf_qsatw(tabs, 0.01*pres, qsat);
+            const Real esat = 100.0*erf_esatw(tabs);
+
+            // r dr/dt = G (S-1), with the heat conduction and vapor diffusion terms
+            const Real Fk = (L_v/(R_v*tabs) - 1.0)*L_v*rhor/(K_a*tabs);
+            const Real Fd = rhor*R_v*tabs/(D_v*esat);
+            const Real G  = 1.0/(Fk + Fd);
+
+            Real dq_cond = 0.0;
+            for (int n = start; n < stop; ++n) {
+                const auto m = perm[n];
+                const Real r_old = rad_ptr[m];
+                const Real r_dry = rdry_ptr[m];
+                const Real r2    = r_old*r_old + 2.0*G*(qv/qsat - 1.0)*a_dt;
+                Real r_new = std::sqrt(std::max(r_dry*r_dry, r2));
+
+                Real dq = xi_ptr[m]*(SuperDroplets_K::droplet_mass(r_new) -
+                                     SuperDroplets_K::droplet_mass(r_old)) / air_mass;
+                if (dq > qv) {
+                    // Cannot condense more than the vapor in the cell
+                    dq = qv;
+                    r_new = std::cbrt(r_old*r_old*r_old + dq*air_mass/(xi_ptr[m]*(4.0/3.0)*PI*rhor));
+                }
+
+                qv      -= dq;
+                dq_cond += dq;
+                rad_ptr[m]  = r_new;
+                mass_ptr[m] = SuperDroplets_K::droplet_mass(r_new);
+            }
+
+            theta_arr(i,j,k) += theta/tabs * a_fac_cond * dq_cond;
+            qv_arr(i,j,k)     = qv;
+
+            //------- Collision-coalescence
+            const int nsd = stop - start;
+            if (nsd > 1) {
+                // Random pairing: shuffle the super-droplets of the cell and pair the
+                // first half with the second half
+                for (int n = nsd-1; n > 0; --n) {
+                    const int l = static_cast<int>(Random_int(n+1, engine));
+                    const auto tmp = perm[start+n];
+                    perm[start+n] = perm[start+l];
+                    perm[start+l] = tmp;
+                }
+
+                const int  npair = nsd/2;
+                const Real scale = static_cast<Real>(nsd)*static_cast<Real>(nsd-1)/(2.0*npair);
+
+                for (int l = 0; l < npair; ++l) {
+                    auto a = perm[start+l];
+                    auto b = perm[start+l+npair];
+                    if (xi_ptr[a] < xi_ptr[b]) { const auto tmp = a; a = b; b = tmp; }
+                    if (xi_ptr[b] <= 0.0) { continue; }
+
+                    const Real ra = rad_ptr[a];
+                    const Real rb = rad_ptr[b];
+                    const Real kernel = PI*(ra+rb)*(ra+rb)*
+                                        std::abs(SuperDroplets_K::terminal_velocity(ra) -
+                                                 SuperDroplets_K::terminal_velocity(rb));
+                    const Real prob = scale*xi_ptr[a]*kernel*a_dt/vol;
+
+                    Real gamma = std::floor(prob);
+                    if (Random(engine) < prob - gamma) { gamma += 1.0; }
+                    if (gamma <= 0.0) { continue; }
+                    gamma = std::min(gamma, std::floor(xi_ptr[a]/xi_ptr[b]));
+
+                    // gamma droplets of a coalesce with each droplet of b
+                    const Real r_new   = std::cbrt(gamma*ra*ra*ra + rb*rb*rb);
+                    const Real rda     = rdry_ptr[a];
+                    const Real rdb     = rdry_ptr[b];
+                    const Real r_dry   = std::cbrt(gamma*rda*rda*rda + rdb*rdb*rdb);
+
+                    if (xi_ptr[a] - gamma*xi_ptr[b] > 0.0) {
+                        xi_ptr[a]  -= gamma*xi_ptr[b];
+                        rad_ptr[b]  = r_new;
+                        rdry_ptr[b] = r_dry;
+                        mass_ptr[b] = SuperDroplets_K::droplet_mass(r_new);
+                    } else {
+                        // a is used up: split the coalesced droplets between a and b
+                        const Real half = std::floor(0.5*xi_ptr[b]);
+                        xi_ptr[a]   = half;
+                        xi_ptr[b]  -= half;
+                        rad_ptr[a]  = r_new;
+                        rad_ptr[b]  = r_new;
+                        rdry_ptr[a] = r_dry;
+                        rdry_ptr[b] = r_dry;
+                        mass_ptr[a] = SuperDroplets_K::droplet_mass(r_new);
+                        mass_ptr[b] = SuperDroplets_K::droplet_mass(r_new);
+                        if (half <= 0.0) { pstruct[a].id() = -1; }
+                    }
+                }
+            }
+
+            //------- Cloud water of the cell
+            Real ql = 0.0;
+            for (int n = start; n < stop; ++n) {
+                const auto m = perm[n];
+                ql += xi_ptr[m]*mass_ptr[m];
+            }
+            qc_arr(i,j,k) = ql / air_mass;
+        });
+    }
+}
+
+/*! Liquid water mass per unit volume of all of the droplets */
+void SuperDropletPC::massDensity ( MultiFab&  a_mf,
+                                   const int& a_lev,
+                                   const int& a_comp ) const
+{
+    BL_PROFILE("SuperDropletPC::massDensity()");
+
+    const auto& geom = Geom(a_lev);
+    const auto plo = geom.ProbLoArray();
+    const auto dxi = geom.InvCellSizeArray();
+
+    const Real inv_cell_volume = dxi[0]*dxi[1]*dxi[2];
+    constexpr int xi_idx = SuperDropletsRealIdxSoA::multiplicity - ERFParticlesRealIdxSoA::ncomps;
+    a_mf.setVal(0.0);
+
+    ParticleToMesh( *this, a_mf, a_lev,
+        [=] AMREX_GPU_DEVICE (  const ERFPC::ParticleTileType::ConstParticleTileDataType& ptr,
+                                int i, Array4<Real> const& rho)
+        {
+            auto p = ptr.m_aos[i];
+            ParticleInterpolator::Linear interp(p, plo, dxi);
+            interp.ParticleToMesh ( p, rho, 0, a_comp, 1,
+                [=] AMREX_GPU_DEVICE ( const ERFPC::ParticleType&, int)
+                {
+                    auto mass = ptr.m_rdata[ERFParticlesRealIdxSoA::mass][i];
+                    auto xi   = ptr.m_runtime_rdata[xi_idx][i];
+                    return xi*mass*inv_cell_volume;
+                });
+        });
+}
+
+/*! Number of droplets per unit volume */
+void SuperDropletPC::numberDensity ( MultiFab&  a_mf,
+                                     const int& a_lev,
+                                     const int& a_comp ) const
+{
+    BL_PROFILE("SuperDropletPC::numberDensity()");
+
+    const auto& geom = Geom(a_lev);
+    const auto plo = geom.ProbLoArray();
+    const auto dxi = geom.InvCellSizeArray();
+
+    const Real inv_cell_volume = dxi[0]*dxi[1]*dxi[2];
+    constexpr int xi_idx = SuperDropletsRealIdxSoA::multiplicity - ERFParticlesRealIdxSoA::ncomps;
+    a_mf.setVal(0.0);
+
+    ParticleToMesh( *this, a_mf, a_lev,
+        [=] AMREX_GPU_DEVICE (  const ERFPC::ParticleTileType::ConstParticleTileDataType& ptr,
+                                int i, Array4<Real> const& num)
+        {
+            auto p = ptr.m_aos[i];
+            ParticleInterpolator::Linear interp(p, plo, dxi);
+            interp.ParticleToMesh ( p, num, 0, a_comp, 1,
+                [=] AMREX_GPU_DEVICE ( const ERFPC::ParticleType&, int)
+                {
+                    return ptr.m_runtime_rdata[xi_idx][i]*inv_cell_volume;
+                });
+        });
+}
+
+/*! Total number of droplets and their liquid water mass (kg) over all ranks */
+void SuperDropletPC::totals ( Real& a_droplets,
+                              Real& a_water ) const
+{
+    BL_PROFILE("SuperDropletPC::totals()");
+
+    const int lev = 0;
+
+    ReduceOps<ReduceOpSum, ReduceOpSum> reduce_op;
+    ReduceData<Real, Real> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+
+    for (ParConstIterType pti(*this, lev); pti.isValid(); ++pti)
+    {
+        const auto& soa = pti.GetStructOfArrays();
+        const int np = pti.numParticles();
+
+        const auto* mass_ptr = soa.GetRealData(ERFParticlesRealIdxSoA::mass).data();
+        const auto* xi_ptr   = soa.GetRealData(SuperDropletsRealIdxSoA::multiplicity).data();
+
+        reduce_op.eval(np, reduce_data,
+        [=] AMREX_GPU_DEVICE (int n) noexcept -> ReduceTuple
+        {
+            return { xi_ptr[n], xi_ptr[n]*mass_ptr[n] };
+        });
+    }
+
+    ReduceTuple hv = reduce_data.value(reduce_op);
+    a_droplets = amrex::get<0>(hv);
+    a_water    = amrex::get<1>(hv);
+    ParallelDescriptor::ReduceRealSum(a_droplets);
+    ParallelDescriptor::ReduceRealSum(a_water);
+}
+
+#endif
@@ -0,0 +1,192 @@
+#include <SuperDroplets.H>
+
+#ifdef ERF_USE_PARTICLES
+
+#include <IndexDefines.H>
+#include <EOS.H>
+
+using namespace amrex;
+
+/**
+ * Creates the super-droplets: ERFPC places the particles (see the ERFPC inputs
+ * of the super_droplets species) and they are then given droplets from the
+ * aerosol distribution.
+ *
+ * @param[in] cons_in Conserved variables input
+ * @param[in] grids The boxes on which we will evolve the solution
+ * @param[in] geom Geometry associated with these MultiFabs and grids
+ * @param[in] dt_advance Timestep for the advance
+ * @param[in] z_phys_nd Nodal z heights
+ * @param[in] detJ_cc Cell-centered Jacobian determinants
+ */
+void SuperDroplets::Init (const MultiFab& cons_in,
+                          const BoxArray& grids,
+                          const Geometry& geom,
+                          const Real& /*dt_advance*/,
+                          std::unique_ptr<MultiFab>& z_phys_nd,
+                          std::unique_ptr<MultiFab>& detJ_cc)
+{
+    m_geom = geom;
+    m_detJ_cc = detJ_cc.get();
+
+    MicVarMap.resize(m_qmoist_size);
+    MicVarMap = {MicVar_SD::qv, MicVar_SD::qc, MicVar_SD::rain_accum};
+
+    // initialize microphysics variables; the density is not allocated since it
+    // is a view of the conserved state (see Copy_State_to_Micro)
+    for (auto ivar = 0; ivar < MicVar_SD::NumVars; ++ivar) {
+        if (ivar == MicVar_SD::rho) continue;
+        mic_fab_vars[ivar] = std::make_shared<MultiFab>(cons_in.boxArray(), cons_in.DistributionMap(),
+                                                        1, cons_in.nGrowVect());
+        mic_fab_vars[ivar]->setVal(0.);
+    }
+
+    // Init is called again on regrid, so drop any view of the old state right away
+    mic_fab_vars[MicVar_SD::rho] = std::make_shared<MultiFab>(cons_in, make_alias, Rho_comp, 1);
+
+    if (m_pc == nullptr) {
+        m_pc = new SuperDropletPC(geom, cons_in.DistributionMap(), grids, m_name);
+        m_pc->InitializeParticles(z_phys_nd);
+        m_pc->initializeDroplets(m_detJ_cc);
+        Print() << "Initialized " << m_pc->TotalNumberOfParticles() << " super-droplets.\n";
+    } else {
+        // New grids for the base level: move the existing droplets onto them
+        m_pc->SetParticleBoxArray(0, grids);
+        m_pc->SetParticleDistributionMap(0, cons_in.DistributionMap());
+        m_pc->Redistribute();
+    }
+}
+
+/**
+ * Gets the potential temperature, vapor and cloud water from the state.
+ *
+ * @param[in] cons_in Conserved variables input
+ */
+void SuperDroplets::Copy_State_to_Micro (const MultiFab& cons_in)
+{
+    // The density is used as is, so alias it rather than copying it
+    mic_fab_vars[MicVar_SD::rho] = std::make_shared<MultiFab>(cons_in, make_alias, Rho_comp, 1);
+
+    for ( MFIter mfi(cons_in, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        const auto& box3d = mfi.tilebox();
+
+        auto states_array = cons_in.const_array(mfi);
+
+        auto theta_array = mic_fab_vars[MicVar_SD::theta]->array(mfi);
+        auto qv_array    = mic_fab_vars[MicVar_SD::qv]->array(mfi);
+        auto qc_array    = mic_fab_vars[MicVar_SD::qc]->array(mfi);
+
+        ParallelFor( box3d, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            theta_array(i,j,k) = states_array(i,j,k,RhoTheta_comp)/states_array(i,j,k,Rho_comp);
+            qv_array(i,j,k)    = states_array(i,j,k,RhoQ1_comp)/states_array(i,j,k,Rho_comp);
+            qc_array(i,j,k)    = states_array(i,j,k,RhoQ2_comp)/states_array(i,j,k,Rho_comp);
+        });
+    }
+}
+
+/**
+ * Puts the potential temperature, vapor and cloud water back into the state.
+ *
+ * @param[out] cons Conserved variables
+ */
+void SuperDroplets::Copy_Micro_to_State (MultiFab& cons)
+{
+    for ( MFIter mfi(cons, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        const auto& box3d = mfi.tilebox();
+
+        auto states_arr = cons.array(mfi);
+
+        auto rho_arr    = mic_fab_vars[MicVar_SD::rho]->const_array(mfi);
+        auto theta_arr  = mic_fab_vars[MicVar_SD::theta]->const_array(mfi);
+        auto qv_arr     = mic_fab_vars[MicVar_SD::qv]->const_array(mfi);
+        auto qc_arr     = mic_fab_vars[MicVar_SD::qc]->const_array(mfi);
+
+        ParallelFor( box3d, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            states_arr(i,j,k,RhoTheta_comp) = rho_arr(i,j,k)*theta_arr(i,j,k);
+            states_arr(i,j,k,RhoQ1_comp)    = rho_arr(i,j,k)*qv_arr(i,j,k);
+            states_arr(i,j,k,RhoQ2_comp)    = rho_arr(i,j,k)*qc_arr(i,j,k);
+        });
+    }
+
+    // Fill interior ghost cells and periodic boundaries
+    cons.FillBoundary(m_geom.periodicity());
+}
+
+/**
+ * Advances the super-droplets by one time step: condensation and coalescence in
+ * the cells they are in, then transport with the flow and fall at their terminal
+ * velocity, and finally redistribution (with optional load balancing) over the
+ * particle boxes.
+ *
+ * The particle boxes may be mapped to other ranks than the mesh data when the
+ * droplets are load balanced, in which case the fields the droplets need are
+ * copied to the particle boxes and back.
+ */
+void SuperDroplets::Advance (const Real& dt_advance,
+                             const int& /*iter*/,
+                             const Real& /*time*/,
+                             Vector<Vector<MultiFab>>& a_vars,
+                             const Vector<std::unique_ptr<MultiFab>>& a_z)
+{
+    BL_PROFILE("SuperDroplets::Advance()");
+
+    const int lev = 0;
+
+    const bool same_grids = m_pc->OnSameGrids(lev, *mic_fab_vars[MicVar_SD::qv]);
+    const BoxArray& pba = m_pc->ParticleBoxArray(lev);
+    const DistributionMapping& pdm = m_pc->ParticleDistributionMap(lev);
+
+    auto on_particle_grids = [&] (const MultiFab& mf) -> MultiFab
+    {
+        if (same_grids) {
+            return MultiFab(mf, make_alias, 0, mf.nComp());
+        }
+        MultiFab tmp(convert(pba, mf.ixType()), pdm, mf.nComp(), mf.nGrowVect());
+        tmp.ParallelCopy(mf, 0, 0, mf.nComp(), mf.nGrowVect(), mf.nGrowVect());
+        return tmp;
+    };
+
+    MultiFab rho   = on_particle_grids(*mic_fab_vars[MicVar_SD::rho]);
+    MultiFab theta = on_particle_grids(*mic_fab_vars[MicVar_SD::theta]);
+    MultiFab qv    = on_particle_grids(*mic_fab_vars[MicVar_SD::qv]);
+    MultiFab qc    = on_particle_grids(*mic_fab_vars[MicVar_SD::qc]);
+    MultiFab rain  = on_particle_grids(*mic_fab_vars[MicVar_SD::rain_accum]);
+
+    std::unique_ptr<MultiFab> detJ;
+    std::unique_ptr<MultiFab> z_phys;
+    if (!same_grids) {
+        if (m_detJ_cc) { detJ   = std::make_unique<MultiFab>(on_particle_grids(*m_detJ_cc)); }
+        if (a_z[lev])  { z_phys = std::make_unique<MultiFab>(on_particle_grids(*a_z[lev])); }
+    }
+    const MultiFab* detJ_pc = (same_grids) ? m_detJ_cc : detJ.get();
+    const std::unique_ptr<MultiFab>& z_pc = (same_grids) ? a_z[lev] : z_phys;
+
+    Real droplets_old = 0.0;
+    Real water_old    = 0.0;
+    if (m_verbose > 0) { m_pc->totals(droplets_old, water_old); }
+
+    m_pc->CondenseAndCollide(dt_advance, rho, theta, qv, qc, detJ_pc, m_fac_cond);
+
+    if (m_verbose > 0) {
+        Real droplets_new, water_new;
+        m_pc->totals(droplets_new, water_new);
+        Print() << "Super-droplets: condensed " << water_new - water_old << " kg of water, "
+                << droplets_old - droplets_new << " droplets lost to coalescence\n";
+    }
+
+    m_pc->AdvectWithFlow(&a_vars[lev][Vars::xvel], lev, dt_advance, z_pc);
+    m_pc->Sediment(dt_advance, z_pc.get(), rain);
+
+    if (!same_grids) {
+        mic_fab_vars[MicVar_SD::theta]->ParallelCopy(theta, 0, 0, 1);
+        mic_fab_vars[MicVar_SD::qv]->ParallelCopy(qv, 0, 0, 1);
+        mic_fab_vars[MicVar_SD::qc]->ParallelCopy(qc, 0, 0, 1);
+        mic_fab_vars[MicVar_SD::rain_accum]->ParallelCopy(rain, 0, 0, 1);
+    }
+
+    m_pc->RedistributeAndBalance();
+}
+
+#endif
@@ -6,6 +6,9 @@
 #include <ERF_Constants.H>
 #include <AMReX_TracerParticle_mod_K.H>
 
+#include <algorithm>
+#include <numeric>
+
 using namespace amrex;
 
 /*! Evolve particles for one time step */
@@ -25,11 +28,111 @@ void ERFPC::EvolveParticles ( int                                        a_lev,
         AdvectWithGravity( a_lev, a_dt_lev, a_z_phys_nd[a_lev] );
     }
 
-    Redistribute();
+    RedistributeAndBalance();
     return;
 }
 
-/*! Uses midpoint method to advance particles using flow velocity. */
+/*! Redistribute the particles, rebalancing the particle boxes over the ranks by
+ *  particle count when they are imbalanced
+ *
+ * Every load_balance_int calls, the cost of a box is taken as its number of
+ * particles plus load_balance_cell_weight times its number of cells. If the
+ * maximum cost per rank exceeds the average by more than load_balance_imbalance,
+ * a knapsack mapping is computed and used if it improves the efficiency (average
+ * over maximum cost per rank) by load_balance_threshold. The particles then get
+ * their own distribution mapping; the mesh data stays where it is and the fields
+ * the particles need are copied to the particle boxes.
+ */
+void ERFPC::RedistributeAndBalance ()
+{
+    BL_PROFILE("ERFPC::RedistributeAndBalance()");
+
+    const int lev = 0;
+
+    if (m_lb_int > 0 && ++m_lb_count >= m_lb_int) {
+        m_lb_count = 0;
+
+        const BoxArray& ba = ParticleBoxArray(lev);
+        const DistributionMapping& dm = ParticleDistributionMap(lev);
+        const int nprocs = ParallelDescriptor::NProcs();
+
+        Vector<Real> cost(ba.size(), 0.0);
+        for (ParIterType pti(*this, lev); pti.isValid(); ++pti) {
+            cost[pti.index()] += static_cast<Real>(pti.numParticles());
+        }
+        ParallelDescriptor::ReduceRealSum(cost.data(), cost.size());
+        for (int ib = 0; ib < ba.size(); ++ib) {
+            cost[ib] += m_lb_cell_weight * static_cast<Real>(ba[ib].numPts());
+        }
+
+        Vector<Real> rank_cost(nprocs, 0.0);
+        for (int ib = 0; ib < ba.size(); ++ib) {
+            rank_cost[dm[ib]] += cost[ib];
+        }
+        const Real max_cost = *std::max_element(rank_cost.begin(), rank_cost.end());
+        const Real sum_cost = std::accumulate(rank_cost.begin(), rank_cost.end(), 0.0);
+        const Real eff_old  = (max_cost > 0.0) ? sum_cost/(nprocs*max_cost) : 1.0;
+
+        // Every rank has the same costs, so they all take the same decisions
+        if (eff_old*m_lb_imbalance < 1.0) {
+            Real eff_new = 0.0;
+            DistributionMapping new_dm = DistributionMapping::makeKnapSack(cost, eff_new, nprocs);
+
+            if (eff_new > m_lb_threshold*eff_old) {
+                SetParticleDistributionMap(lev, new_dm);
+                if (m_verbose > 0) {
+                    Print() << "ERFPC: rebalanced " << m_name << ", efficiency "
+                            << eff_old << " -> " << eff_new << "\n";
+                }
+            }
+        }
+    }
+
+    Redistribute();
+    SortIfNeeded();
+}
+
+/*! Copy of a mesh field on the particle boxes with at least a_ng ghost cells.
+ *  The particle boxes may be mapped to other ranks than the mesh data when the
+ *  particles are load balanced, and the stages of the advection may reach more
+ *  ghost cells than the mesh data has. Returns nullptr if a_mf can be used as is. */
+std::unique_ptr<MultiFab>
+ERFPC::CopyToParticleGrids ( const MultiFab& a_mf,
+                             int             a_lev,
+                             const IntVect&  a_ng )
+{
+    if (OnSameGrids(a_lev, a_mf) && a_mf.nGrowVect().allGE(a_ng)) {
+        return nullptr;
+    }
+
+    IntVect ng_src = a_mf.nGrowVect();
+    IntVect ng = max(ng_src, a_ng);
+    auto mf = std::make_unique<MultiFab>(convert(m_gdb->ParticleBoxArray(a_lev), a_mf.ixType()),
+                                         m_gdb->ParticleDistributionMap(a_lev), a_mf.nComp(), ng);
+    mf->setVal(0.0);
+    mf->ParallelCopy(a_mf, 0, 0, a_mf.nComp(), ng_src, ng, m_gdb->Geom(a_lev).periodicity());
+    return mf;
+}
+
+/*! Sort the particles of each tile by cell every sort_int calls, so that the
+ *  particles next to each other in memory gather the same face values */
+void ERFPC::SortIfNeeded ()
+{
+    if (m_sort_int > 0 && ++m_sort_count >= m_sort_int) {
+        BL_PROFILE("ERFPC::SortIfNeeded()");
+        m_sort_count = 0;
+        SortParticlesByCell();
+    }
+}
+
+/*! Advance the particles with the flow velocity, with the midpoint method or with
+ *  the three-stage SSP Runge-Kutta scheme (see advect_position). The velocity is
+ *  that of the end of the step at every stage, so the schemes are only second or
+ *  third order when the flow is steady. All the stages are done in the same
+ *  kernel; the face values gathered at one stage are reused at the next when it
+ *  falls in the same stencil. The velocities (and heights) are copied with enough
+ *  ghost cells for the particles that move farthest, so that the particles may
+ *  cross several cells per step. */
 void ERFPC::AdvectWithFlow ( MultiFab*                           a_umac,
                              int                                 a_lev,
                              Real                                a_dt,
@@ -52,90 +155,100 @@ void ERFPC::AdvectWithFlow ( MultiFab*                           a_umac,
     const auto plo = geom.ProbLoArray();
     const auto dxi = geom.InvCellSizeArray();
 
+    // Ghost cells the stencils of the stages may reach
+    Real umax[AMREX_SPACEDIM];
+    for (int i = 0; i < AMREX_SPACEDIM; i++) {
+        umax[i] = a_umac[i].norminf(0, 0, true);
+    }
+    ParallelDescriptor::ReduceRealMax(umax, AMREX_SPACEDIM);
+    IntVect ng_stages;
+    for (int i = 0; i < AMREX_SPACEDIM; i++) {
+        ng_stages[i] = static_cast<int>(std::ceil(umax[i]*a_dt*dxi[i])) + 1;
+    }
+
     Vector<std::unique_ptr<MultiFab> > raii_umac(AMREX_SPACEDIM);
     Vector<MultiFab*> umac_pointer(AMREX_SPACEDIM);
-    if (OnSameGrids(a_lev, a_umac[0]))
+    for (int i = 0; i < AMREX_SPACEDIM; i++)
     {
-        for (int i = 0; i < AMREX_SPACEDIM; i++) {
-            umac_pointer[i] = &a_umac[i];
-        }
+        raii_umac[i] = CopyToParticleGrids(a_umac[i], a_lev, ng_stages);
+        umac_pointer[i] = (raii_umac[i]) ? raii_umac[i].get() : &a_umac[i];
     }
-    else
-    {
-        for (int i = 0; i < AMREX_SPACEDIM; i++)
-        {
-            IntVect ng = a_umac[i].nGrowVect();
-            raii_umac[i] = std::make_unique<MultiFab>
-                (convert(m_gdb->ParticleBoxArray(a_lev), IntVect::TheDimensionVector(i)),
-                 m_gdb->ParticleDistributionMap(a_lev), a_umac[i].nComp(), ng);
-            umac_pointer[i] = raii_umac[i].get();
-            umac_pointer[i]->ParallelCopy(a_umac[i],0,0,a_umac[i].nComp(),ng,ng);
-        }
+
+    std::unique_ptr<MultiFab> raii_z;
+    const MultiFab* z_pointer = a_z_height.get();
+    if (a_z_height) {
+        raii_z = CopyToParticleGrids(*a_z_height, a_lev, ng_stages);
+        if (raii_z) { z_pointer = raii_z.get(); }
     }
 
-    for (int ipass = 0; ipass < 2; ipass++)
-    {
+    const bool rk3 = (m_advection_scheme == ERFParticleAdvection::rk3);
+
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
-        for (ParIterType pti(*this, a_lev); pti.isValid(); ++pti)
+    for (ParIterType pti(*this, a_lev); pti.isValid(); ++pti)
+    {
+        int grid    = pti.index();
+        auto& ptile = ParticlesAt(a_lev, pti);
+        auto& aos  = ptile.GetArrayOfStructs();
+        auto& soa  = ptile.GetStructOfArrays();
+        const int n = aos.numParticles();
+        auto *p_pbox = aos().data();
+
+        Array<ParticleReal*,AMREX_SPACEDIM> v_ptr;
+        v_ptr[0] = soa.GetRealData(ERFParticlesRealIdxSoA::vx).data();
+        v_ptr[1] = soa.GetRealData(ERFParticlesRealIdxSoA::vy).data();
+        v_ptr[2] = soa.GetRealData(ERFParticlesRealIdxSoA::vz).data();
+
+        const FArrayBox* fab[AMREX_SPACEDIM] = { AMREX_D_DECL(&((*umac_pointer[0])[grid]),
+                                                              &((*umac_pointer[1])[grid]),
+                                                              &((*umac_pointer[2])[grid])) };
+
+        //array of these pointers to pass to the GPU
+        GpuArray<Array4<const Real>, AMREX_SPACEDIM>
+            const umacarr {{AMREX_D_DECL((*fab[0]).array(),
+                                         (*fab[1]).array(),
+                                         (*fab[2]).array() )}};
+
+        bool use_terrain = (z_pointer != nullptr);
+        auto zheight = use_terrain ? (*z_pointer)[grid].const_array() : Array4<const Real>{};
+
+        ParallelFor(n, [=] AMREX_GPU_DEVICE (int i)
         {
-            int grid    = pti.index();
-            auto& ptile = ParticlesAt(a_lev, pti);
-            auto& aos  = ptile.GetArrayOfStructs();
-            auto& soa  = ptile.GetStructOfArrays();
-            const int n = aos.numParticles();
-            auto *p_pbox = aos().data();
-
-            Array<ParticleReal*,AMREX_SPACEDIM> v_ptr;
-            v_ptr[0] = soa.GetRealData(ERFParticlesRealIdxSoA::vx).data();
-            v_ptr[1] = soa.GetRealData(ERFParticlesRealIdxSoA::vy).data();
-            v_ptr[2] = soa.GetRealData(ERFParticlesRealIdxSoA::vz).data();
-
-            const FArrayBox* fab[AMREX_SPACEDIM] = { AMREX_D_DECL(&((*umac_pointer[0])[grid]),
-                                                                  &((*umac_pointer[1])[grid]),
-                                                                  &((*umac_pointer[2])[grid])) };
-
-            //array of these pointers to pass to the GPU
-            GpuArray<Array4<const Real>, AMREX_SPACEDIM>
-                const umacarr {{AMREX_D_DECL((*fab[0]).array(),
-                                             (*fab[1]).array(),
-                                             (*fab[2]).array() )}};
-
-            bool use_terrain = (a_z_height != nullptr);
-            auto zheight = use_terrain ? (*a_z_height)[grid].array() : Array4<Real>{};
-
-            ParallelFor(n, [=] AMREX_GPU_DEVICE (int i)
-            {
-                ParticleType& p = p_pbox[i];
-                if (p.id() <= 0) { return; }
+            ParticleType& p = p_pbox[i];
+            if (p.id() <= 0) { return; }
 
-                ParticleReal v[AMREX_SPACEDIM];
+            ParticleReal pos[AMREX_SPACEDIM];
+            ParticleReal v[AMREX_SPACEDIM];
+            MACStencil stencil;
+
+            // Velocity at a stage position
+            auto vel = [&] (const ParticleReal* a_pos, ParticleReal* a_v)
+            {
+                for (int dim=0; dim < AMREX_SPACEDIM; dim++) {
+                    p.pos(dim) = a_pos[dim];
+                }
+                // Update z-coordinate carried by the particle
+                update_location_idata(p,plo,dxi,zheight);
                 if (use_terrain) {
-                    mac_interpolate_mapped_z(p, plo, dxi, umacarr, zheight, v);
+                    mac_interpolate_mapped_z(p, plo, dxi, umacarr, zheight, a_v);
                 } else {
-                    mac_interpolate(p, plo, dxi, umacarr, v);
+                    mac_interpolate_cached(p, plo, dxi, umacarr, stencil, a_v);
                 }
+            };
 
-                if (ipass == 0) {
-                    for (int dim=0; dim < AMREX_SPACEDIM; dim++)
-                    {
-                        v_ptr[dim][i] = p.pos(dim);
-                        p.pos(dim) += static_cast<ParticleReal>(ParticleReal(0.5)*a_dt*v[dim]);
-                    }
-                    // Update z-coordinate carried by the particle
-                    update_location_idata(p,plo,dxi,zheight);
-                } else {
-                    for (int dim=0; dim < AMREX_SPACEDIM; dim++)
-                    {
-                        p.pos(dim) = v_ptr[dim][i] + static_cast<ParticleReal>(a_dt*v[dim]);
-                        v_ptr[dim][i] = v[dim];
-                    }
-                    // Update z-coordinate carried by the particle
-                    update_location_idata(p,plo,dxi,zheight);
-                }
-            });
-        }
+            for (int dim=0; dim < AMREX_SPACEDIM; dim++) {
+                pos[dim] = p.pos(dim);
+            }
+
+            advect_position(pos, a_dt, rk3, vel, v);
+
+            for (int dim=0; dim < AMREX_SPACEDIM; dim++) {
+                p.pos(dim) = pos[dim];
+                v_ptr[dim][i] = v[dim];
+            }
+            update_location_idata(p,plo,dxi,zheight);
+        });
     }
 
     if (m_verbose > 1)
@@ -167,6 +280,13 @@ void ERFPC::AdvectWithGravity (  int                                 a_lev,
     const auto plo = geom.ProbLoArray();
     const auto dxi = geom.InvCellSizeArray();
 
+    std::unique_ptr<MultiFab> raii_z;
+    const MultiFab* z_pointer = a_z_height.get();
+    if (a_z_height) {
+        raii_z = CopyToParticleGrids(*a_z_height, a_lev, a_z_height->nGrowVect());
+        if (raii_z) { z_pointer = raii_z.get(); }
+    }
+
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
@@ -181,8 +301,8 @@ void ERFPC::AdvectWithGravity (  int                                 a_lev,
 
         auto vz_ptr = soa.GetRealData(ERFParticlesRealIdxSoA::vz).data();
 
-        bool use_terrain = (a_z_height != nullptr);
-        auto zheight = use_terrain ? (*a_z_height)[grid].array() : Array4<Real>{};
+        bool use_terrain = (z_pointer != nullptr);
+        auto zheight = use_terrain ? (*z_pointer)[grid].const_array() : Array4<const Real>{};
 
         ParallelFor(n, [=] AMREX_GPU_DEVICE (int i)
         {
@@ -49,6 +49,30 @@ void ERFPC::readInputs ()
     m_advect_w_gravity = (m_name == ERFParticleNames::hydro ? true : false);
     pp.query("advect_with_gravity", m_advect_w_gravity);
 
+    m_advection_scheme = ERFParticleAdvection::midpoint;
+    pp.query("advection_scheme", m_advection_scheme);
+    if (m_advection_scheme != ERFParticleAdvection::midpoint &&
+        m_advection_scheme != ERFParticleAdvection::rk3) {
+        Abort("ERFPC: " + m_name + ".advection_scheme must be midpoint or rk3");
+    }
+
+    m_sort_int = 0;
+    pp.query("sort_int", m_sort_int);
+
+    m_lb_int = 0;
+    pp.query("load_balance_int", m_lb_int);
+    m_lb_cell_weight = 1.0;
+    pp.query("load_balance_cell_weight", m_lb_cell_weight);
+    m_lb_imbalance = 1.0;
+    pp.query("load_balance_imbalance", m_lb_imbalance);
+    m_lb_threshold = 1.1;
+    pp.query("load_balance_threshold", m_lb_threshold);
+
+    // The balanced particle boxes only exist on the base level
+    if (m_lb_int > 0 && m_gdb->maxLevel() > 0) {
+        Abort("ERFPC: " + m_name + ".load_balance_int is only supported on a single level");
+    }
+
     return;
 }
 
@@ -29,15 +29,11 @@ void AerRadProps::initialize (int num_gas, int num_modes, int naeroes,
     nrh      = num_rh;
     top_lev  = top_levels;
 
-    // NOTE: pmid is absolute pressure but pdeldry is the vertical
-    //       change in pressure (analog to mass per area with HSE balance)
+    // NOTE: pmid is a view of the caller's columns, so it follows their updates;
+    //       pdeldry has its own storage (see compute_pdeldry)
     pmid    = pmiddle;
-    pdeldry = pmiddle;
-    parallel_for(SimpleBounds<2>(ncol, nlev), YAKL_LAMBDA (int icol, int ilev)
-    {
-        // Pressure max at bottom of column
-        pdeldry(icol,ilev) = pmid(icol,ilev) -  pmid(icol,ilev+1);
-    });
+    pdeldry = real2d("pdeldry", ncol, nlev);
+    compute_pdeldry();
 
     temp = temperature;
     qt   = qtotal;
@@ -49,6 +45,21 @@ void AerRadProps::initialize (int num_gas, int num_modes, int naeroes,
     mam_aer.initialize(ncol, nlev, top_lev, nswbands, nlwbands);
 }
 
+void AerRadProps::compute_pdeldry ()
+{
+    // NOTE: pmid is absolute pressure but pdeldry is the vertical
+    //       change in pressure (analog to mass per area with HSE balance)
+    auto pmid_v    = pmid;
+    auto pdeldry_v = pdeldry;
+    int  nlev_v    = nlev;
+    parallel_for(SimpleBounds<2>(ncol, nlev), YAKL_LAMBDA (int icol, int ilev)
+    {
+        // Pressure max at bottom of column; the top layer uses the one below
+        int kb = (ilev < nlev_v) ? ilev : ilev-1;
+        pdeldry_v(icol,ilev) = pmid_v(icol,kb) - pmid_v(icol,kb+1);
+    });
+}
+
 void AerRadProps::aer_rad_props_sw (const int& list_idx, const real& dt, const int& nnite,
                                     const int1d& idxnite, const bool is_cmip6_volc, const real3d& tau, const real3d& tau_w,
                                     const real3d& tau_w_g, const real3d& tau_w_f, const real2d& clear_rh)
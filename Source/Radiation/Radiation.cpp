@@ -48,6 +48,19 @@ namespace internal {
         fluxes.bnd_flux_dn_dir = real3d("flux_dn_dir", nz, nlay+1, nbands);
     }
 
+    void reset_fluxes (FluxesByband& fluxes)
+    {
+        yakl::memset(fluxes.flux_up    , 0.);
+        yakl::memset(fluxes.flux_dn    , 0.);
+        yakl::memset(fluxes.flux_net   , 0.);
+        yakl::memset(fluxes.flux_dn_dir, 0.);
+
+        yakl::memset(fluxes.bnd_flux_up    , 0.);
+        yakl::memset(fluxes.bnd_flux_dn    , 0.);
+        yakl::memset(fluxes.bnd_flux_net   , 0.);
+        yakl::memset(fluxes.bnd_flux_dn_dir, 0.);
+    }
+
     void expand_day_fluxes (const FluxesByband& daytime_fluxes,
                             FluxesByband& expanded_fluxes,
                             const int1d& day_indices)
@@ -108,6 +121,7 @@ void Radiation::initialize (const MultiFab& cons_in,
                             const BoxArray& grids,
                             const Geometry& geom,
                             const Real& dt_advance,
+                            const Real& time,
                             const bool& do_sw_rad,
                             const bool& do_lw_rad,
                             const bool& do_aero_rad,
@@ -136,20 +150,145 @@ void Radiation::initialize (const MultiFab& cons_in,
     m_lsm_fluxes = lsm_fluxes;
     m_lsm_zenith = lsm_zenith;
 
-    rrtmgp_data_path = getRadiationDataDir() + "/";
-    rrtmgp_coefficients_file_sw = rrtmgp_data_path + rrtmgp_coefficients_file_name_sw;
-    rrtmgp_coefficients_file_lw = rrtmgp_data_path + rrtmgp_coefficients_file_name_lw;
-
     ParmParse pp("erf");
     pp.query("fixed_total_solar_irradiance", fixed_total_solar_irradiance);
     pp.query("radiation_uniform_angle"     , uniform_angle);
+    pp.query("radiation_start_day"         , start_calday);
+
+    // A sun that moves between calls needs the orbital zenith angle, so the
+    // default uniform angle is not used then and a positive one is an error
+    bool update_zenith = false;
+    pp.query("radiation_update_zenith", update_zenith);
+    if (update_zenith) {
+        if (pp.contains("radiation_uniform_angle")) {
+            if (uniform_angle > 0.0) {
+                Abort("erf.radiation_update_zenith cannot be used with a positive erf.radiation_uniform_angle");
+            }
+        } else {
+            uniform_angle = -1.0;
+        }
+    }
+
+    calday = start_calday + time / 86400.0;
+
+    // Radiation on every col_stride-th column only, optionally from a random
+    // offset drawn for each call
+    pp.query("radiation_column_stride", col_stride);
+    pp.query("radiation_column_jitter", col_jitter);
+    AMREX_ALWAYS_ASSERT(col_stride >= 1);
+    col_ox = 0;
+    col_oy = 0;
+    if (col_jitter && col_stride > 1) {
+        if (ParallelDescriptor::IOProcessor()) {
+            col_ox = amrex::Random_int(col_stride);
+            col_oy = amrex::Random_int(col_stride);
+        }
+        ParallelDescriptor::Bcast(&col_ox, 1, ParallelDescriptor::IOProcessorNumber());
+        ParallelDescriptor::Bcast(&col_oy, 1, ParallelDescriptor::IOProcessorNumber());
+    }
+
+    // The sampled columns of all the local boxes follow each other in the
+    // radiation arrays
+    int ncol_in = 0, nlev_in = 0;
+    col_offset.assign(cons_in.boxArray().size(), 0);
+    for ( MFIter mfi(cons_in); mfi.isValid(); ++mfi) {
+        const auto& box3d = mfi.validbox();
+        nlev_in = box3d.length(2);
+        col_offset[mfi.index()] = ncol_in;
+        ncol_in += RadColumnMap(box3d, col_stride).ncol();
+    }
+
+    // The gas optics and the workspace only depend on the column count, so
+    // they are kept from one call to the next
+    if (!m_workspace_ready || ncol_in != ncol || nlev_in != nlev) {
+        ncol = ncol_in;
+        nlev = nlev_in;
+        setup_workspace();
+    }
+
+    // Get the temperature, pressure and moisture columns from the state, with the
+    // interface values of the pressure and temperature
+    int klo = 0;
+    int khi = nlev-1;
+    auto qt_v = qt; auto qc_v = qc; auto qi_v = qi; auto qn_v = qn;
+    auto tmid_v = tmid; auto pmid_v = pmid; auto pdel_v = pdel;
+    auto pint_v = pint; auto tint_v = tint; auto zi_v = zi;
+    for (MFIter mfi(cons_in); mfi.isValid(); ++mfi) {
+        const auto& vbx = mfi.validbox();
+        RadColumnMap cmap = column_map(vbx, mfi.index());
+
+        // The sampled columns
+        Box sbx(IntVect(0, 0, vbx.smallEnd(2)), IntVect(cmap.nxs-1, cmap.nys-1, vbx.bigEnd(2)));
+
+        auto states_array = cons_in.array(mfi);
+        auto qt_array = (qmoist[0]) ? qmoist[0]->array(mfi) : Array4<Real> {};
+        auto qv_array = (qmoist[1]) ? qmoist[1]->array(mfi) : Array4<Real> {};
+        auto qc_array = (qmoist[2]) ? qmoist[2]->array(mfi) : Array4<Real> {};
+        auto qi_array = (qmoist.size()>=8) ? qmoist[3]->array(mfi) : Array4<Real> {};
+
+        ParallelFor(sbx, [=] AMREX_GPU_DEVICE (int is, int js, int k)
+        {
+            int i = cmap.sample_i(is);
+            int j = cmap.sample_j(js);
+            auto icol = cmap.icol(is,js);
+            auto ilev = k+1;
 
-    for ( MFIter mfi(cons_in, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
-        const auto& box3d = mfi.tilebox();
-        nlev = box3d.length(2);
-        ncol = box3d.length(0)*box3d.length(1);
+            // NOTE: RRTMGP code expects pressure in pa
+            auto get_pt = [&] (int kk, Real& p, Real& t)
+            {
+                Real qv = (qv_array) ? qv_array(i,j,kk): 0.0;
+                t = getTgivenRandRTh(states_array(i,j,kk,Rho_comp),states_array(i,j,kk,RhoTheta_comp),qv);
+                p = getPgivenRTh(states_array(i,j,kk,RhoTheta_comp),qv);
+            };
+
+            Real p, t, pb, tb, pa, ta;
+            get_pt(k, p, t);
+            if (k == klo) {
+                get_pt(k+1, pa, ta);
+                pb = 2.0*p - pa; tb = 2.0*t - ta;
+            } else {
+                get_pt(k-1, pb, tb);
+                if (k == khi) {
+                    pa = 2.0*p - pb; ta = 2.0*t - tb;
+                } else {
+                    get_pt(k+1, pa, ta);
+                }
+            }
+
+            qt_v(icol,ilev)   = (qt_array) ? qt_array(i,j,k): 0.0;
+            qc_v(icol,ilev)   = (qc_array) ? qc_array(i,j,k): 0.0;
+            qi_v(icol,ilev)   = (qi_array) ? qi_array(i,j,k): 0.0;
+            qn_v(icol,ilev)   = qc_v(icol,ilev) + qi_v(icol,ilev);
+            tmid_v(icol,ilev) = t;
+            pmid_v(icol,ilev) = p;
+
+            // Interfaces below and above the cell; the outer ones are extrapolated
+            Real plo = 0.5*(pb + p), tlo = 0.5*(tb + t);
+            Real phi = 0.5*(p + pa), thi = 0.5*(t + ta);
+            pint_v(icol,ilev) = plo;
+            tint_v(icol,ilev) = tlo;
+            if (k == khi) {
+                pint_v(icol,ilev+1) = phi;
+                tint_v(icol,ilev+1) = thi;
+            }
+            pdel_v(icol,ilev) = phi - plo;
+            zi_v(icol,ilev)   = lowz + (ilev+0.5)*dz;
+        });
     }
 
+    // The aerosol optics keep views of the columns, but their layer
+    // pressure thickness has to be recomputed
+    optics.update_aerosol_pressure();
+}
+
+// Load the gas, cloud and aerosol optics, and allocate the column arrays
+// used by every radiation call
+void Radiation::setup_workspace ()
+{
+    rrtmgp_data_path = getRadiationDataDir() + "/";
+    rrtmgp_coefficients_file_sw = rrtmgp_data_path + rrtmgp_coefficients_file_name_sw;
+    rrtmgp_coefficients_file_lw = rrtmgp_data_path + rrtmgp_coefficients_file_name_lw;
+
     ngas = active_gases.size();
 
     // initialize cloud, aerosol, and radiation
@@ -164,12 +303,13 @@ void Radiation::initialize (const MultiFab& cons_in,
     nlwgpts  = radiation.get_ngpt_lw();
 
     rrtmg_to_rrtmgp = int1d("rrtmg_to_rrtmgp",14);
+    auto rrtmg_to_rrtmgp_v = rrtmg_to_rrtmgp;
     parallel_for(14, YAKL_LAMBDA (int i)
     {
         if (i == 1) {
-            rrtmg_to_rrtmgp(i) = 13;
+            rrtmg_to_rrtmgp_v(i) = 13;
         } else {
-            rrtmg_to_rrtmgp(i) = i - 1;
+            rrtmg_to_rrtmgp_v(i) = i - 1;
         }
     });
 
@@ -186,53 +326,6 @@ void Radiation::initialize (const MultiFab& cons_in,
     qn   = real2d("qn", ncol, nlev);
     zi   = real2d("zi", ncol, nlev);
 
-    // Get the temperature, density, theta, qt and qp from input
-    for (MFIter mfi(cons_in); mfi.isValid(); ++mfi) {
-        const auto& box3d = mfi.tilebox();
-        auto nx = box3d.length(0);
-
-        auto states_array = cons_in.array(mfi);
-        auto qt_array = (qmoist[0]) ? qmoist[0]->array(mfi) : Array4<Real> {};
-        auto qv_array = (qmoist[1]) ? qmoist[1]->array(mfi) : Array4<Real> {};
-        auto qc_array = (qmoist[2]) ? qmoist[2]->array(mfi) : Array4<Real> {};
-        auto qi_array = (qmoist.size()>=8) ? qmoist[3]->array(mfi) : Array4<Real> {};
-
-        // Get pressure, theta, temperature, density, and qt, qp
-        ParallelFor(box3d, [=] AMREX_GPU_DEVICE (int i, int j, int k)
-        {
-            auto icol = j*nx+i+1;
-            auto ilev = k+1;
-            Real qv         = (qv_array) ? qv_array(i,j,k): 0.0;
-            qt(icol,ilev)   = (qt_array) ? qt_array(i,j,k): 0.0;
-            qc(icol,ilev)   = (qc_array) ? qc_array(i,j,k): 0.0;
-            qi(icol,ilev)   = (qi_array) ? qi_array(i,j,k): 0.0;
-            qn(icol,ilev)   = qc(icol,ilev) + qi(icol,ilev);
-            tmid(icol,ilev) = getTgivenRandRTh(states_array(i,j,k,Rho_comp),states_array(i,j,k,RhoTheta_comp),qv);
-            // NOTE: RRTMGP code expects pressure in pa
-            pmid(icol,ilev) = getPgivenRTh(states_array(i,j,k,RhoTheta_comp),qv);
-        });
-    }
-
-    parallel_for(SimpleBounds<2>(ncol, nlev+1), YAKL_LAMBDA (int icol, int ilev)
-    {
-        if (ilev == 1) {
-            pint(icol, 1) = -0.5*pmid(icol, 2) + 1.5*pmid(icol, 1);
-            tint(icol, 1) = -0.5*tmid(icol, 2) + 1.5*tmid(icol, 1);
-        } else if (ilev <= nlev) {
-            pint(icol, ilev) = 0.5*(pmid(icol, ilev-1) + pmid(icol, ilev));
-            tint(icol, ilev) = 0.5*(tmid(icol, ilev-1) + tmid(icol, ilev));
-        } else {
-            pint(icol, nlev+1) = -0.5*pmid(icol, nlev-1) + 1.5*pmid(icol, nlev);
-            tint(icol, nlev+1) = -0.5*tmid(icol, nlev-1) + 1.5*tmid(icol, nlev);
-        }
-    });
-
-    parallel_for(SimpleBounds<2>(ncol, nlev), YAKL_LAMBDA (int icol, int ilev)
-    {
-        zi(icol, ilev)  = lowz + (ilev+0.5)*dz;
-        pdel(icol,ilev) = pint(icol,ilev+1) - pint(icol,ilev);
-    });
-
     albedo_dir = real2d("albedo_dir", nswbands, ncol);
     albedo_dif = real2d("albedo_dif", nswbands, ncol);
 
@@ -244,6 +337,66 @@ void Radiation::initialize (const MultiFab& cons_in,
     qrsc = real2d("qrsc", ncol, nlev);
     qrlc = real2d("qrlc", ncol, nlev);
 
+    clear_rh = real2d("clear_rh", ncol, nswbands);
+
+    coszrs = real1d("coszrs", ncol);
+
+    cld      = real2d("cld"     , ncol, nlev);
+    cldfsnow = real2d("cldfsnow", ncol, nlev);
+    iclwp    = real2d("iclwp"   , ncol, nlev);
+    iciwp    = real2d("iciwp"   , ncol, nlev);
+    icswp    = real2d("icswp"   , ncol, nlev);
+    dei      = real2d("dei"     , ncol, nlev);
+    des      = real2d("des"     , ncol, nlev);
+    lambdac  = real2d("lambdac" , ncol, nlev);
+    mu       = real2d("mu"      , ncol, nlev);
+    rei      = real2d("rei"     , ncol, nlev);
+    rel      = real2d("rel"     , ncol, nlev);
+
+    cld_tau_gpt_sw = real3d("cld_tau_gpt_sw", ncol, nlev, nswgpts);
+    cld_ssa_gpt_sw = real3d("cld_ssa_gpt_sw", ncol, nlev, nswgpts);
+    cld_asm_gpt_sw = real3d("cld_asm_gpt_sw", ncol, nlev, nswgpts);
+
+    cld_tau_bnd_sw = real3d("cld_tau_bnd_sw", ncol, nlev, nswbands);
+    cld_ssa_bnd_sw = real3d("cld_ssa_bnd_sw", ncol, nlev, nswbands);
+    cld_asm_bnd_sw = real3d("cld_asm_bnd_sw", ncol, nlev, nswbands);
+
+    aer_tau_bnd_sw = real3d("aer_tau_bnd_sw", ncol, nlev, nswbands);
+    aer_ssa_bnd_sw = real3d("aer_ssa_bnd_sw", ncol, nlev, nswbands);
+    aer_asm_bnd_sw = real3d("aer_asm_bnd_sw", ncol, nlev, nswbands);
+
+    cld_tau_bnd_lw = real3d("cld_tau_bnd_lw", ncol, nlev, nlwbands);
+    aer_tau_bnd_lw = real3d("aer_tau_bnd_lw", ncol, nlev, nlwbands);
+
+    cld_tau_gpt_lw = real3d("cld_tau_gpt_lw", ncol, nlev, nlwgpts);
+
+    liq_tau_bnd_sw = real3d("liq_tau_bnd_sw", ncol, nlev, nswbands);
+    ice_tau_bnd_sw = real3d("ice_tau_bnd_sw", ncol, nlev, nswbands);
+    snw_tau_bnd_sw = real3d("snw_tau_bnd_sw", ncol, nlev, nswbands);
+    liq_tau_bnd_lw = real3d("liq_tau_bnd_lw", ncol, nlev, nlwbands);
+    ice_tau_bnd_lw = real3d("ice_tau_bnd_lw", ncol, nlev, nlwbands);
+    snw_tau_bnd_lw = real3d("snw_tau_bnd_lw", ncol, nlev, nlwbands);
+
+    gas_vmr = real3d("gas_vmr", ngas, ncol, nlev);
+
+    cld_tau_gpt_lw_rad = real3d("cld_tau_gpt_lw_rad", ncol, nlev+1, nlwgpts);
+    aer_tau_bnd_lw_rad = real3d("aer_tau_bnd_lw_rad", ncol, nlev+1, nlwgpts);
+    gas_vmr_lw_rad     = real3d("gas_vmr_lw_rad", ngas, ncol, nlev);
+
+    // Surface emissivity needed for longwave
+    surface_emissivity = real2d("surface_emissivity", nlwbands, ncol);
+
+    day_indices   = int1d("day_indices"  , ncol);
+    night_indices = int1d("night_indices", ncol);
+
+    radiation.get_gpoint_bands_sw(gpoint_bands_sw);
+    radiation.get_gpoint_bands_lw(gpoint_bands_lw);
+
+    internal::initial_fluxes(ncol, nlev+1, nswbands, fluxes_sw_allsky);
+    internal::initial_fluxes(ncol, nlev+1, nswbands, fluxes_sw_clrsky);
+    internal::initial_fluxes(ncol, nlev, nlwbands, fluxes_lw_allsky);
+    internal::initial_fluxes(ncol, nlev, nlwbands, fluxes_lw_clrsky);
+
     int nmodes = 3;
     int nrh = 1;
     int top_lev = 1;
@@ -252,94 +405,56 @@ void Radiation::initialize (const MultiFab& cons_in,
     auto geom_radius = real2d("geom_radius", ncol, nlev);
     yakl::memset(geom_radius, 0.1);
 
+    // The aerosol optics keep views of the column arrays, which are refilled
+    // in place by every call
     optics.initialize(ngas, nmodes, naer, nswbands, nlwbands,
                       ncol, nlev, nrh, top_lev, aero_names, zi,
                       pmid, pint, tmid, qt, geom_radius);
 
+    m_workspace_ready = true;
+
     amrex::Print() << "LW coefficients file: " << rrtmgp_coefficients_file_lw
                    << "\nSW coefficients file: " << rrtmgp_coefficients_file_sw
                    << "\nFrequency (timesteps) of Shortwave Radiation calc: " << dt
                    << "\nFrequency (timesteps) of Longwave Radiation calc:  " << dt
                    << "\nDo aerosol radiative calculations: " << do_aerosol_rad << std::endl;
-
 }
 
 
 // run radiation model
 void Radiation::run ()
 {
-    // Cosine solar zenith angle for all columns in chunk
-    real1d coszrs("coszrs", ncol);
-
-    // Pointers to fields on the physics buffer
-    real2d cld("cld"  , ncol, nlev), cldfsnow("cldfsnow", ncol, nlev),
-         iclwp("iclwp", ncol, nlev),    iciwp("iciwp"   , ncol, nlev),
-         icswp("icswp", ncol, nlev),      dei("dei"     , ncol, nlev),
-           des("des"  , ncol, nlev),  lambdac("lambdac" , ncol, nlev),
-            mu("mu"   , ncol, nlev),      rei("rei"     , ncol, nlev),
-           rel("rel"  , ncol, nlev);
-
-    // Cloud, snow, and aerosol optical properties
-    real3d cld_tau_gpt_sw("cld_tau_gpt_sw", ncol, nlev, nswgpts),
-           cld_ssa_gpt_sw("cld_ssa_gpt_sw", ncol, nlev, nswgpts),
-           cld_asm_gpt_sw("cld_asm_gpt_sw", ncol, nlev, nswgpts);
-
-    real3d cld_tau_bnd_sw("cld_tau_bnd_sw", ncol, nlev, nswbands),
-           cld_ssa_bnd_sw("cld_ssa_bnd_sw", ncol, nlev, nswbands),
-           cld_asm_bnd_sw("cld_asm_bnd_sw", ncol, nlev, nswbands);
-
-    real3d aer_tau_bnd_sw("aer_tau_bnd_sw", ncol, nlev, nswbands),
-           aer_ssa_bnd_sw("aer_ssa_bnd_sw", ncol, nlev, nswbands),
-           aer_asm_bnd_sw("aer_asm_bnd_sw", ncol, nlev, nswbands);
-
-    real3d cld_tau_bnd_lw("cld_tau_bnd_lw", ncol, nlev, nlwbands),
-           aer_tau_bnd_lw("aer_tau_bnd_lw", ncol, nlev, nlwbands);
-
-    real3d cld_tau_gpt_lw("cld_tau_gpt_lw", ncol, nlev, nlwgpts);
-
-    // NOTE: these are diagnostic only
-    real3d liq_tau_bnd_sw("liq_tau_bnd_sw", ncol, nlev, nswbands),
-           ice_tau_bnd_sw("ice_tau_bnd_sw", ncol, nlev, nswbands),
-           snw_tau_bnd_sw("snw_tau_bnd_sw", ncol, nlev, nswbands);
-    real3d liq_tau_bnd_lw("liq_tau_bnd_lw", ncol, nlev, nlwbands),
-           ice_tau_bnd_lw("ice_tau_bnd_lw", ncol, nlev, nlwbands),
-           snw_tau_bnd_lw("snw_tau_bnd_lw", ncol, nlev, nlwbands);
-
-    // Gas volume mixing ratios
-    real3d gas_vmr("gas_vmr", ngas, ncol, nlev);
-
-    // Needed for shortwave aerosol;
-    //int nday, nnight;     // Number of daylight columns
-    int1d day_indices("day_indices", ncol), night_indices("night_indices", ncol);   // Indices of daylight coumns
+    // NOTE: The column arrays and the optical properties are members, allocated
+    //       once by setup_workspace and overwritten by every call
+
+    // Views of the workspace, so that the device lambdas below do not capture this
+    auto cld = this->cld, cldfsnow = this->cldfsnow;
+    auto iclwp = this->iclwp, iciwp = this->iciwp, icswp = this->icswp;
+    auto qt = this->qt, qi = this->qi, qn = this->qn, pmid = this->pmid, pdel = this->pdel;
+    auto qrs = this->qrs, qrl = this->qrl;
+    auto cld_tau_bnd_sw = this->cld_tau_bnd_sw, cld_ssa_bnd_sw = this->cld_ssa_bnd_sw,
+         cld_asm_bnd_sw = this->cld_asm_bnd_sw;
+    auto aer_tau_bnd_sw = this->aer_tau_bnd_sw, aer_ssa_bnd_sw = this->aer_ssa_bnd_sw,
+         aer_asm_bnd_sw = this->aer_asm_bnd_sw;
+    auto rrtmg_to_rrtmgp = this->rrtmg_to_rrtmgp;
+    const int nswbands = this->nswbands;
 
     // Flag to carry (QRS,QRL)*dp across time steps.
     // TODO: what does this mean?
     bool conserve_energy = true;
 
-    // For loops over diagnostic calls
-    //bool active_calls(0:N_DIAG)
-
-    // Zero-array for cloud properties if not diagnosed by microphysics
-    real2d zeros("zeros", ncol, nlev);
-
-    int1d gpoint_bands_sw("gpoint_bands_sw", nswgpts);
-    int1d gpoint_bands_lw("gpoint_bands_lw", nlwgpts);
-
     // Do shortwave stuff...
     if (do_short_wave_rad) {
         // Radiative fluxes
-        FluxesByband fluxes_allsky, fluxes_clrsky;
-        internal::initial_fluxes(ncol, nlev+1, nswbands, fluxes_allsky);
-        internal::initial_fluxes(ncol, nlev+1, nswbands, fluxes_clrsky);
+        FluxesByband& fluxes_allsky = fluxes_sw_allsky;
+        FluxesByband& fluxes_clrsky = fluxes_sw_clrsky;
 
-        // TODO: Integrate calendar day computation
-        int calday = 1;
         // Get cosine solar zenith angle for current time step.
         if (m_lat) {
-            zenith(calday, m_lat, m_lon, coszrs, ncol,
+            zenith(calday, m_lat, m_lon, coszrs, ncol, col_stride, col_ox, col_oy, col_offset,
                    eccen,  mvelpp, lambm0, obliqr);
         } else {
-            zenith(calday, m_lat, m_lon, coszrs, ncol,
+            zenith(calday, m_lat, m_lon, coszrs, ncol, col_stride, col_ox, col_oy, col_offset,
                    eccen,  mvelpp, lambm0, obliqr, uniform_angle);
         }
 
@@ -403,8 +518,6 @@ void Radiation::run ()
 
         // And now do the MCICA sampling to get cloud optical properties by
         // gpoint/cloud state
-        radiation.get_gpoint_bands_sw(gpoint_bands_sw);
-
         optics.sample_cloud_optics_sw(ncol, nlev, nswgpts, gpoint_bands_sw,
                                       pmid, cld, cldfsnow,
                                       cld_tau_bnd_sw, cld_ssa_bnd_sw, cld_asm_bnd_sw,
@@ -434,7 +547,6 @@ void Radiation::run ()
                 yakl::memset(aer_ssa_bnd_sw, 0.);
                 yakl::memset(aer_asm_bnd_sw, 0.);
 
-                real2d clear_rh("clear_rh",ncol, nswbands);
                 yakl::memset(clear_rh, 0.01);
 
                 optics.set_aerosol_optics_sw(0, ncol, nlev, nswbands, dt, night_indices,
@@ -498,10 +610,9 @@ void Radiation::run ()
 
     // Do longwave stuff...
     if (do_long_wave_rad) {
-        // Allocate longwave outputs; why is this not part of the fluxes_t object?
-        FluxesByband fluxes_allsky, fluxes_clrsky;
-        internal::initial_fluxes(ncol, nlev, nlwbands, fluxes_allsky);
-        internal::initial_fluxes(ncol, nlev, nlwbands, fluxes_clrsky);
+        // Longwave outputs
+        FluxesByband& fluxes_allsky = fluxes_lw_allsky;
+        FluxesByband& fluxes_clrsky = fluxes_lw_clrsky;
 
         // NOTE: fluxes defined at interfaces, so initialize to have vertical dimension nlev_rad+1
         yakl::memset(cld_tau_gpt_lw, 0.);
@@ -510,8 +621,6 @@ void Radiation::run ()
                                    lambdac, mu, dei, des, rei,
                                    cld_tau_bnd_lw, liq_tau_bnd_lw, ice_tau_bnd_lw, snw_tau_bnd_lw);
 
-        radiation.get_gpoint_bands_lw(gpoint_bands_lw);
-
         optics.sample_cloud_optics_lw(ncol, nlev, nlwgpts, gpoint_bands_lw,
                                       pmid, cld, cldfsnow,
                                       cld_tau_bnd_lw, cld_tau_gpt_lw);
@@ -546,20 +655,27 @@ void Radiation::run ()
     // Populate source term for theta dycore variable
     for (MFIter mfi(*(qrad_src)); mfi.isValid(); ++mfi) {
         auto qrad_src_array = qrad_src->array(mfi);
-        const auto& box3d = mfi.tilebox();
-        auto nx = box3d.length(0);
+        const auto& box3d = mfi.validbox();
+        RadColumnMap cmap = column_map(box3d, mfi.index());
         amrex::ParallelFor(box3d, [=] AMREX_GPU_DEVICE (int i, int j, int k)
         {
-            // Map (col,lev) to (i,j,k)
-            auto icol = j*nx+i+1;
+            // Map (col,lev) to (i,j,k), interpolating between the sampled columns
+            int icol[4];
+            Real wgt[4];
+            cmap.weights(i, j, icol, wgt);
             auto ilev = k+1;
 
             // TODO: We do not include the cloud source term qrsc/qrlc.
             //       Do these simply sum for a net source or do we pick one?
 
             // SW and LW sources
-            qrad_src_array(i,j,k,0) = qrs(icol,ilev);
-            qrad_src_array(i,j,k,1) = qrl(icol,ilev);
+            Real sw = 0.0, lw = 0.0;
+            for (int n = 0; n < 4; ++n) {
+                sw += wgt[n] * qrs(icol[n],ilev);
+                lw += wgt[n] * qrl(icol[n],ilev);
+            }
+            qrad_src_array(i,j,k,0) = sw;
+            qrad_src_array(i,j,k,1) = lw;
         });
     }
 }
@@ -572,13 +688,18 @@ void Radiation::radiation_driver_sw (int ncol, const real3d& gas_vmr,
                                      FluxesByband& fluxes_clrsky, FluxesByband& fluxes_allsky, const real2d& qrs,
                                      const real2d& qrsc)
 {
+    // The flux arrays are kept between calls, and only the day columns are
+    // written below, so the night columns must not keep the last call's fluxes
+    internal::reset_fluxes(fluxes_allsky);
+    internal::reset_fluxes(fluxes_clrsky);
+
     // Incoming solar radiation, scaled for solar zenith angle
     // and earth-sun distance
     real2d solar_irradiance_by_gpt("solar_irradiance_by_gpt",ncol,nswgpts);
 
     // Gathered indices of day and night columns
     // chunk_column_index = day_indices(daylight_column_index)
-    int1d day_indices("day_indices",ncol), night_indices("night_indices", ncol);   // Indices of daylight coumns
+    auto day_indices = this->day_indices, night_indices = this->night_indices;
 
     real1d coszrs_day("coszrs_day", ncol);
     real2d albedo_dir_day("albedo_dir_day", nswbands, ncol), albedo_dif_day("albedo_dif_day", nswbands, ncol);
@@ -610,8 +731,6 @@ void Radiation::radiation_driver_sw (int ncol, const real3d& gas_vmr,
     real solar_declination;
 
     if (fixed_total_solar_irradiance<0) {
-        // TODO: Integrate calendar day computation
-        int calday = 1;
         // Get orbital eccentricity factor to scale total sky irradiance
         shr_orb_decl(calday, eccen, mvelpp, lambm0, obliqr, solar_declination, tsi_scaling);
     } else {
@@ -643,8 +762,6 @@ void Radiation::radiation_driver_sw (int ncol, const real3d& gas_vmr,
 
     // If no daytime columns in this chunk, then we return zeros
     if (num_day(1) == 0) {
-        //    reset_fluxes(fluxes_allsky)
-        //    reset_fluxes(fluxes_clrsky)
         yakl::memset(qrs, 0.);
         yakl::memset(qrsc, 0.);
         return;
@@ -738,14 +855,10 @@ void Radiation::radiation_driver_lw (int ncol, int nlev,
                                      const real3d& cld_tau_gpt, const real3d& aer_tau_bnd, FluxesByband& fluxes_clrsky,
                                      FluxesByband& fluxes_allsky, const real2d& qrl, const real2d& qrlc)
 {
-    real3d cld_tau_gpt_rad("cld_tau_gpt_rad", ncol, nlev+1, nlwgpts);
-    real3d aer_tau_bnd_rad("aer_tau_bnd_rad", ncol, nlev+1, nlwgpts);
-
-    // Surface emissivity needed for longwave
-    real2d surface_emissivity("surface_emissivity", nlwbands, ncol);
-
-    // Temporary heating rates on radiation vertical grid
-    real3d gas_vmr_rad("gas_vmr_rad", ngas, ncol, nlev);
+    // Inputs on the radiation vertical grid, from the workspace
+    real3d& cld_tau_gpt_rad = cld_tau_gpt_lw_rad;
+    real3d& aer_tau_bnd_rad = aer_tau_bnd_lw_rad;
+    real3d& gas_vmr_rad     = gas_vmr_lw_rad;
 
     // Set surface emissivity to 1 here. There is a note in the RRTMG
     // implementation that this is treated in the land model, but the old
@@ -968,58 +1081,76 @@ Radiation::export_surface_fluxes(FluxesByband& fluxes,
         // Populate the LSM data structure (this is a 2D MF)
         for (MFIter mfi(*(m_lsm_fluxes)); mfi.isValid(); ++mfi) {
             auto lsm_array = m_lsm_fluxes->array(mfi);
-            const auto& box3d = mfi.tilebox();
-            auto nx = box3d.length(0);
+            const auto& box3d = mfi.validbox();
+            RadColumnMap cmap = column_map(box3d, mfi.index());
             amrex::ParallelFor(box3d, [=] AMREX_GPU_DEVICE (int i, int j, int k)
             {
-                // Map (col,lev) to (i,j,k)
-                auto icol = j*nx+i+1;
+                // Map (col,lev) to (i,j,k), interpolating between the sampled columns
+                int icols[4];
+                Real wgt[4];
+                cmap.weights(i, j, icols, wgt);
                 auto ilev = k+1;
 
-                // Direct fluxes
-                Real sum1(0.0), sum2(0.0);
-                for (int ibnd(1); ibnd<=9; ++ibnd) {
-                    sum1 += fluxes.bnd_flux_dn_dir(icol,ilev,ibnd);
-                }
-                for (int ibnd(11); ibnd<=14; ++ibnd) {
-                    sum2 += fluxes.bnd_flux_dn_dir(icol,ilev,ibnd);
-                }
-                sum1 += 0.5 * fluxes.bnd_flux_dn_dir(icol,ilev,10);
-                sum2 += 0.5 * fluxes.bnd_flux_dn_dir(icol,ilev,10);
-                lsm_array(i,j,k,0) = sum1;
-                lsm_array(i,j,k,1) = sum2;
-
-                // Diffuse fluxes
-                sum1=0.0; sum2=0.0;
-                for (int ibnd(1); ibnd<=9; ++ibnd) {
-                    sum1 += flux_dn_diffuse(icol,ilev,ibnd);
-                }
-                for (int ibnd(11); ibnd<=14; ++ibnd) {
-                    sum2 += flux_dn_diffuse(icol,ilev,ibnd);
-                }
-                sum1 += 0.5 * flux_dn_diffuse(icol,ilev,10);
-                sum2 += 0.5 * flux_dn_diffuse(icol,ilev,10);
-                lsm_array(i,j,k,2) = sum1;
-                lsm_array(i,j,k,3) = sum2;
+                Real dir1(0.0), dir2(0.0), dif1(0.0), dif2(0.0), net(0.0);
+                for (int n = 0; n < 4; ++n) {
+                    auto icol = icols[n];
 
-                // Net fluxes
-                lsm_array(i,j,k,4) = fluxes.flux_net(icol,ilev);
+                    // Direct fluxes
+                    Real sum1(0.0), sum2(0.0);
+                    for (int ibnd(1); ibnd<=9; ++ibnd) {
+                        sum1 += fluxes.bnd_flux_dn_dir(icol,ilev,ibnd);
+                    }
+                    for (int ibnd(11); ibnd<=14; ++ibnd) {
+                        sum2 += fluxes.bnd_flux_dn_dir(icol,ilev,ibnd);
+                    }
+                    sum1 += 0.5 * fluxes.bnd_flux_dn_dir(icol,ilev,10);
+                    sum2 += 0.5 * fluxes.bnd_flux_dn_dir(icol,ilev,10);
+                    dir1 += wgt[n] * sum1;
+                    dir2 += wgt[n] * sum2;
+
+                    // Diffuse fluxes
+                    sum1=0.0; sum2=0.0;
+                    for (int ibnd(1); ibnd<=9; ++ibnd) {
+                        sum1 += flux_dn_diffuse(icol,ilev,ibnd);
+                    }
+                    for (int ibnd(11); ibnd<=14; ++ibnd) {
+                        sum2 += flux_dn_diffuse(icol,ilev,ibnd);
+                    }
+                    sum1 += 0.5 * flux_dn_diffuse(icol,ilev,10);
+                    sum2 += 0.5 * flux_dn_diffuse(icol,ilev,10);
+                    dif1 += wgt[n] * sum1;
+                    dif2 += wgt[n] * sum2;
+
+                    // Net fluxes
+                    net += wgt[n] * fluxes.flux_net(icol,ilev);
+                }
+                lsm_array(i,j,k,0) = dir1;
+                lsm_array(i,j,k,1) = dir2;
+                lsm_array(i,j,k,2) = dif1;
+                lsm_array(i,j,k,3) = dif2;
+                lsm_array(i,j,k,4) = net;
             });
         }
     } else if (band == "longwave") {
         // Populate the LSM data structure (this is a 2D MF)
         for (MFIter mfi(*(m_lsm_fluxes)); mfi.isValid(); ++mfi) {
             auto lsm_array = m_lsm_fluxes->array(mfi);
-            const auto& box3d = mfi.tilebox();
-            auto nx = box3d.length(0);
+            const auto& box3d = mfi.validbox();
+            RadColumnMap cmap = column_map(box3d, mfi.index());
             amrex::ParallelFor(box3d, [=] AMREX_GPU_DEVICE (int i, int j, int k)
             {
-                // Map (col,lev) to (i,j,k)
-                auto icol = j*nx+i+1;
+                // Map (col,lev) to (i,j,k), interpolating between the sampled columns
+                int icols[4];
+                Real wgt[4];
+                cmap.weights(i, j, icols, wgt);
                 auto ilev = k+1;
 
                 // Net fluxes
-                lsm_array(i,j,k,5) = fluxes.flux_dn(icol,ilev);
+                Real flux_dn = 0.0;
+                for (int n = 0; n < 4; ++n) {
+                    flux_dn += wgt[n] * fluxes.flux_dn(icols[n],ilev);
+                }
+                lsm_array(i,j,k,5) = flux_dn;
             });
         }
     } else {
@@ -1030,3 +1161,45 @@ Radiation::export_surface_fluxes(FluxesByband& fluxes,
 // call back
 void Radiation::on_complete () { }
 
+// Between radiation calls, the SW heating follows the cosine of the solar
+// zenith angle; columns where the sun has set since the call get none, and
+// those where it has risen get none until the next call.
+void Radiation::refresh_zenith (const Real& time_call,
+                                const Real& time,
+                                MultiFab* lat,
+                                MultiFab* lon,
+                                MultiFab& qheating_rates)
+{
+    // A uniform angle does not move (initialize rejects one with update_zenith)
+    if (uniform_angle > 0.0) return;
+
+    Real calday_call = start_calday + time_call / 86400.0;
+    Real calday_now  = start_calday + time      / 86400.0;
+
+    Real delta_call, delta_now, eccf;
+    shr_orb_decl(calday_call, eccen, mvelpp, lambm0, obliqr, delta_call, eccf);
+    shr_orb_decl(calday_now , eccen, mvelpp, lambm0, obliqr, delta_now , eccf);
+
+    // Same constant location as zenith() without lat/lon
+    Real cons_lat = 40.0;
+    Real cons_lon = 100.0;
+    Real uangle = uniform_angle;
+
+    for (MFIter mfi(qheating_rates, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        const auto& tbx = mfi.tilebox();
+        auto qrad_array = qheating_rates.array(mfi);
+        auto lat_array  = (lat) ? lat->const_array(mfi) : Array4<const Real> {};
+        auto lon_array  = (lon) ? lon->const_array(mfi) : Array4<const Real> {};
+
+        ParallelFor(tbx, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            // NOTE: lat/lon are 2D multifabs!
+            Real clat = (lat_array) ? lat_array(i,j,0) : cons_lat;
+            Real clon = (lon_array) ? lon_array(i,j,0) : cons_lon;
+            Real cosz_call = shr_orb_cosz(calday_call, clat, clon, delta_call, uangle);
+            Real cosz_now  = shr_orb_cosz(calday_now , clat, clon, delta_now , uangle);
+            qrad_array(i,j,k,0) *= (cosz_call > 0.0) ? amrex::max(cosz_now, 0.0) / cosz_call : 0.0;
+        });
+    }
+}
+
@@ -24,6 +24,10 @@ ERF::Advance (int lev, Real time, Real dt_lev, int iteration, int /*ncycle*/)
     // We must swap the pointers so the previous step's "new" is now this step's "old"
     std::swap(vars_old[lev], vars_new[lev]);
 
+    // The integrator state is rebuilt below, so nothing is known about its ghost cells yet
+    ghosts_old[lev].define(vars_old[lev][Vars::cons].nComp());
+    ghosts_new[lev].define(vars_new[lev][Vars::cons].nComp());
+
     MultiFab& S_old = vars_old[lev][Vars::cons];
     MultiFab& S_new = vars_new[lev][Vars::cons];
 
@@ -84,6 +88,7 @@ ERF::Advance (int lev, Real time, Real dt_lev, int iteration, int /*ncycle*/)
 
     FillPatch(lev, time, {&S_old, &U_old, &V_old, &W_old},
                          {&S_old, &rU_old[lev], &rV_old[lev], &rW_old[lev]});
+    ghosts_old[lev].set_valid(IntVars::cons, S_old.nGrowVect());
 
     if (solverChoice.moisture_type != MoistureType::None) {
         // TODO: This is only qv
@@ -94,7 +99,10 @@ ERF::Advance (int lev, Real time, Real dt_lev, int iteration, int /*ncycle*/)
 #if defined(ERF_USE_WINDFARM)
     if (solverChoice.windfarm_type != WindFarmType::None) {
         advance_windfarm(Geom(lev), dt_lev, S_old,
-                         U_old, V_old, W_old, vars_windfarm[lev], Nturb[lev]);
+                         U_old, V_old, W_old, Nturb[lev]);
+
+        // The Fitch and EWP models add to the valid QKE after its ghost cells were filled
+        ghosts_old[lev].invalidate(IntVars::cons, RhoQKE_comp, 1);
     }
 
 #endif
@@ -161,7 +169,7 @@ ERF::Advance (int lev, Real time, Real dt_lev, int iteration, int /*ncycle*/)
     // **************************************************************************************
     // Update the radiation
     // **************************************************************************************
-    advance_radiation(lev, S_new, dt_lev);
+    advance_radiation(lev, S_new, dt_lev, time);
 #endif
 
 #ifdef ERF_USE_PARTICLES
@@ -176,28 +184,34 @@ ERF::Advance (int lev, Real time, Real dt_lev, int iteration, int /*ncycle*/)
     // **************************************************************************************
     if (lev < finest_level)
     {
+        // We must fill the ghost cells that the parallel copy reads, but only those the
+        //    integrator has not already filled since their valid data was last changed
+        auto fill_for_copy = [&] (int ivar, const IntVect& ng)
+        {
+            if (!ghosts_old[lev].is_valid(ivar, ng)) {
+                state_old[ivar].FillBoundary(0, state_old[ivar].nComp(), ng, geom[lev].periodicity());
+            }
+            if (!ghosts_new[lev].is_valid(ivar, ng)) {
+                state_new[ivar].FillBoundary(0, state_new[ivar].nComp(), ng, geom[lev].periodicity());
+            }
+        };
+
         if (cf_width > 0) {
-            // We must fill the ghost cells of these so that the parallel copy works correctly
-            state_old[IntVars::cons].FillBoundary(geom[lev].periodicity());
-            state_new[IntVars::cons].FillBoundary(geom[lev].periodicity());
+            fill_for_copy(IntVars::cons, FPr_c[lev].CrseNGrowVect(state_old[IntVars::cons]));
             FPr_c[lev].RegisterCoarseData({&state_old[IntVars::cons], &state_new[IntVars::cons]},
                                           {time, time + dt_lev});
         }
 
         if (cf_width >= 0) {
-            // We must fill the ghost cells of these so that the parallel copy works correctly
-            state_old[IntVars::xmom].FillBoundary(geom[lev].periodicity());
-            state_new[IntVars::xmom].FillBoundary(geom[lev].periodicity());
+            fill_for_copy(IntVars::xmom, FPr_u[lev].CrseNGrowVect(state_old[IntVars::xmom]));
             FPr_u[lev].RegisterCoarseData({&state_old[IntVars::xmom], &state_new[IntVars::xmom]},
                                           {time, time + dt_lev});
 
-            state_old[IntVars::ymom].FillBoundary(geom[lev].periodicity());
-            state_new[IntVars::ymom].FillBoundary(geom[lev].periodicity());
+            fill_for_copy(IntVars::ymom, FPr_v[lev].CrseNGrowVect(state_old[IntVars::ymom]));
             FPr_v[lev].RegisterCoarseData({&state_old[IntVars::ymom], &state_new[IntVars::ymom]},
                                           {time, time + dt_lev});
 
-            state_old[IntVars::zmom].FillBoundary(geom[lev].periodicity());
-            state_new[IntVars::zmom].FillBoundary(geom[lev].periodicity());
+            fill_for_copy(IntVars::zmom, FPr_w[lev].CrseNGrowVect(state_old[IntVars::zmom]));
             FPr_w[lev].RegisterCoarseData({&state_old[IntVars::zmom], &state_new[IntVars::zmom]},
                                           {time, time + dt_lev});
         }
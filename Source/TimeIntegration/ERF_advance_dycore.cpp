@@ -104,9 +104,37 @@ void ERF::advance_dycore(int level,
 
     int num_prim = state_old[IntVars::cons].nComp() - 1;
 
+    // *************************************************************************
+    // Number of acoustic substeps between halo exchanges of the fast variables.
+    // Between exchanges the fast variables are also advanced on the ghost cells,
+    //    which requires the domain to be periodic wherever those ghost cells are
+    //    outside of it. Each substep needs one more layer of the conserved
+    //    variables than of the momenta, and the map factors one layer beyond that.
+    // *************************************************************************
+    int fast_halo_depth = 1;
+    if ( (solverChoice.fast_halo_depth > 1) && (level == 0) && !l_use_terrain &&
+         !solverChoice.use_NumDiff && fine_geom.isPeriodic(0) && fine_geom.isPeriodic(1) )
+    {
+        fast_halo_depth = std::min({solverChoice.fast_halo_depth,
+                                    state_old[IntVars::cons].nGrow(),
+                                    state_old[IntVars::xmom].nGrow()+1,
+                                    mapfac_u[level]->nGrow()});
+    }
+    IntVect ng_fast_max(fast_halo_depth-1,fast_halo_depth-1,0);
+
     MultiFab    S_prim  (ba  , dm, num_prim,          state_old[IntVars::cons].nGrowVect());
     MultiFab  pi_stage  (ba  , dm,        1,          state_old[IntVars::cons].nGrowVect());
-    MultiFab fast_coeffs(ba_z, dm,        5,          0);
+    MultiFab fast_coeffs(ba_z, dm,        5,          ng_fast_max);
+
+    // The fast coefficients need the base state on every cell they are computed on
+    MultiFab base_state_fast;
+    if (fast_halo_depth-1 > base_state[level].nGrow()) {
+        base_state_fast.define(ba, dm, 3, IntVect(fast_halo_depth-1,fast_halo_depth-1,1));
+        MultiFab::Copy(base_state_fast, base_state[level], 0, 0, 3, base_state[level].nGrowVect());
+        base_state_fast.FillBoundary(fine_geom.periodicity());
+    }
+    MultiFab r0_fast (base_state_fast.ok() ? base_state_fast : base_state[level], make_alias, 0, 1);
+    MultiFab pi0_fast(base_state_fast.ok() ? base_state_fast : base_state[level], make_alias, 2, 1);
     MultiFab* eddyDiffs = eddyDiffs_lev[level].get();
     MultiFab* SmnSmn    = SmnSmn_lev[level].get();
 
@@ -274,6 +302,14 @@ void ERF::advance_dycore(int level,
               fast_only, vel_and_mom_synced);
     cons_to_prim(state_old[IntVars::cons], state_old[IntVars::cons].nGrow());
 
+    // The first substep of each stage reads the old momenta on every ghost cell it advances,
+    //    but VelocityToMomentum above only rebuilt one layer of them
+    if (fast_halo_depth > 2) {
+        for (int ivar = IntVars::xmom; ivar <= IntVars::zmom; ++ivar) {
+            state_old[ivar].FillBoundary(ng_fast_max, fine_geom.periodicity());
+        }
+    }
+
 #include "TI_no_substep_fun.H"
 #include "TI_slow_rhs_fun.H"
 #include "TI_fast_rhs_fun.H"
@@ -300,6 +336,9 @@ void ERF::advance_dycore(int level,
     mri_integrator.set_slow_fast_timestep_ratio(fixed_mri_dt_ratio > 0 ? fixed_mri_dt_ratio : dt_mri_ratio[level]);
     mri_integrator.set_no_substep(no_substep_fun);
 
+    // The integrator starts by copying state_old, ghost cells included, into state_new
+    ghosts_new[level] = ghosts_old[level];
+
     mri_integrator.advance(state_old, state_new, old_time, dt_advance);
 
     if (verbose) Print() << "Done with advance_dycore at level " << level << std::endl;
@@ -12,5 +12,6 @@ void ERF::advance_microphysics (int lev,
         micro->Update_Micro_Vars_Lev(lev, cons);
         micro->Advance(lev, dt_advance, iteration, time, solverChoice, vars_new, z_phys_nd);
         micro->Update_State_Vars_Lev(lev, cons);
+        ghosts_new[lev].invalidate(IntVars::cons);
     }
 }
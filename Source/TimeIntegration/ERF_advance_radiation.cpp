@@ -3,32 +3,81 @@
 using namespace amrex;
 
 #if defined(ERF_USE_RRTMGP)
+/**
+ * Update the radiative heating rates. The radiation is solved every
+ * erf.radiation_period of simulated time (every step if not positive);
+ * in between, the heating rates of the last call are held, or ramped from
+ * those of the call before, and the shortwave heating can follow the sun.
+ *
+ * @param[in] lev        level of refinement
+ * @param[in] cons       conserved state at the new time
+ * @param[in] dt_advance time step
+ * @param[in] time       time at the start of the step
+ */
 void ERF::advance_radiation (int lev,
                              MultiFab& cons,
-                             const Real& dt_advance)
+                             const Real& dt_advance,
+                             const Real& time)
 {
-   bool do_sw_rad {true};
-   bool do_lw_rad {true};
-   bool do_aero_rad {true};
-   bool do_snow_opt {true};
-   bool is_cmip6_volcano {false};
-
-    rad.initialize(cons,
-                   sw_lw_fluxes[lev].get(),
-                   solar_zenith[lev].get(),
-                   qheating_rates[lev].get(),
-                   lat_m[lev].get(),
-                   lon_m[lev].get(),
-                   qmoist[lev],
-                   grids[lev],
-                   Geom(lev),
-                   dt_advance,
-                   do_sw_rad,
-                   do_lw_rad,
-                   do_aero_rad,
-                   do_snow_opt,
-                   is_cmip6_volcano);
-    rad.run();
-    rad.on_complete();
+    bool do_sw_rad {true};
+    bool do_lw_rad {true};
+    bool do_aero_rad {true};
+    bool do_snow_opt {true};
+    bool is_cmip6_volcano {false};
+
+    const Real rad_time = time + dt_advance;
+
+    bool do_call = (rad_period <= 0.0) || (rad_last_time[lev] < 0.0) ||
+                   is_it_time_for_action(istep[lev]+1, rad_time, dt_advance, -1, rad_period);
+
+    if (do_call) {
+        rad.initialize(cons,
+                       sw_lw_fluxes[lev].get(),
+                       solar_zenith[lev].get(),
+                       qheating_rates[lev].get(),
+                       lat_m[lev].get(),
+                       lon_m[lev].get(),
+                       qmoist[lev],
+                       grids[lev],
+                       Geom(lev),
+                       dt_advance,
+                       rad_time,
+                       do_sw_rad,
+                       do_lw_rad,
+                       do_aero_rad,
+                       do_snow_opt,
+                       is_cmip6_volcano);
+        rad.run();
+        rad.on_complete();
+
+        if (rad_period > 0.0) {
+            // The first call has no predecessor to ramp from
+            MultiFab& prev_src = (rad_last_time[lev] < 0.0) ? *qheating_rates[lev] : *qheating_rates_last[lev];
+            if (rad_interp_linear) {
+                MultiFab::Copy(*qheating_rates_prev[lev], prev_src, 0, 0, 2, 0);
+            }
+            MultiFab::Copy(*qheating_rates_last[lev], *qheating_rates[lev], 0, 0, 2, 0);
+        }
+        rad_last_time[lev] = rad_time;
+    }
+
+    if (rad_period <= 0.0) return;
+
+    // Heating rates between the calls
+    if (rad_interp_linear) {
+        Real w = amrex::min(Real(1.0), amrex::max(Real(0.0), (rad_time - rad_last_time[lev]) / rad_period));
+        MultiFab::LinComb(*qheating_rates[lev],
+                          1.0-w, *qheating_rates_prev[lev], 0,
+                          w    , *qheating_rates_last[lev], 0,
+                          0, 2, 0);
+    } else if (!do_call) {
+        MultiFab::Copy(*qheating_rates[lev], *qheating_rates_last[lev], 0, 0, 2, 0);
+    }
+
+    if (rad_update_zenith) {
+        rad.refresh_zenith(rad_last_time[lev], rad_time,
+                           lat_m[lev].get(), lon_m[lev].get(),
+                           *qheating_rates[lev]);
+    }
 }
 #endif
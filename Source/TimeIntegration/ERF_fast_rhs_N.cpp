@@ -29,6 +29,7 @@ using namespace amrex;
  * @param[inout] fr_as_crse YAFluxRegister at level l at level l   / l+1 interface
  * @param[inout] fr_as_fine YAFluxRegister at level l at level l-1 / l   interface
  * @param[in]    l_reflux should we add fluxes to the FluxRegisters?
+ * @param[in]    ng_fast  number of lateral ghost cells on which S_data is also advanced
  */
 
 void erf_fast_rhs_N (int step, int nrk,
@@ -51,7 +52,8 @@ void erf_fast_rhs_N (int step, int nrk,
                      YAFluxRegister* fr_as_crse,
                      YAFluxRegister* fr_as_fine,
                      bool l_use_moisture,
-                     bool l_reflux)
+                     bool l_reflux,
+                     int ng_fast)
 {
     BL_PROFILE_REGION("erf_fast_rhs_N()");
 
@@ -71,9 +73,15 @@ void erf_fast_rhs_N (int step, int nrk,
     const auto& ba = S_stage_data[IntVars::cons].boxArray();
     const auto& dm = S_stage_data[IntVars::cons].DistributionMap();
 
-    MultiFab Delta_rho_w(    convert(ba,IntVect(0,0,1)), dm, 1, IntVect(1,1,0));
-    MultiFab Delta_rho  (            ba                , dm, 1, 1);
-    MultiFab Delta_rho_theta(        ba                , dm, 1, 1);
+    // When advancing on ng_fast ghost cells we need one more layer of the increments
+    const IntVect ngf   (ng_fast  ,ng_fast  ,0);
+    const IntVect ngf_cc(ng_fast+1,ng_fast+1,1);
+
+    const IntVect ngf_w(std::max(ng_fast,1),std::max(ng_fast,1),0);
+
+    MultiFab Delta_rho_w(    convert(ba,IntVect(0,0,1)), dm, 1, ngf_w);
+    MultiFab Delta_rho  (            ba                , dm, 1, ngf_cc);
+    MultiFab Delta_rho_theta(        ba                , dm, 1, ngf_cc);
 
     MultiFab     coeff_A_mf(fast_coeffs, make_alias, 0, 1);
     MultiFab inv_coeff_B_mf(fast_coeffs, make_alias, 1, 1);
@@ -87,14 +95,14 @@ void erf_fast_rhs_N (int step, int nrk,
     const GpuArray<Real,AMREX_SPACEDIM> grav_gpu{grav[0], grav[1], grav[2]};
 
     // This will hold theta extrapolated forward in time
-    MultiFab extrap(S_data[IntVars::cons].boxArray(),S_data[IntVars::cons].DistributionMap(),1,1);
+    MultiFab extrap(S_data[IntVars::cons].boxArray(),S_data[IntVars::cons].DistributionMap(),1,ngf_cc);
 
     // This will hold the update for (rho) and (rho theta)
-    MultiFab temp_rhs(S_stage_data[IntVars::zmom].boxArray(),S_stage_data[IntVars::zmom].DistributionMap(),2,0);
+    MultiFab temp_rhs(S_stage_data[IntVars::zmom].boxArray(),S_stage_data[IntVars::zmom].DistributionMap(),2,ngf);
 
     // This will hold the new x- and y-momenta temporarily (so that we don't overwrite values we need when tiling)
-    MultiFab temp_cur_xmom(S_stage_data[IntVars::xmom].boxArray(),S_stage_data[IntVars::xmom].DistributionMap(),1,0);
-    MultiFab temp_cur_ymom(S_stage_data[IntVars::ymom].boxArray(),S_stage_data[IntVars::ymom].DistributionMap(),1,0);
+    MultiFab temp_cur_xmom(S_stage_data[IntVars::xmom].boxArray(),S_stage_data[IntVars::xmom].DistributionMap(),1,ngf);
+    MultiFab temp_cur_ymom(S_stage_data[IntVars::ymom].boxArray(),S_stage_data[IntVars::ymom].DistributionMap(),1,ngf);
 
     // *************************************************************************
     // First set up some arrays we'll need
@@ -117,7 +125,7 @@ void erf_fast_rhs_N (int step, int nrk,
         const Array4<const Real>&  prev_zmom = S_prev[IntVars::zmom].const_array(mfi);
         const Array4<const Real>& stage_zmom = S_stage_data[IntVars::zmom].const_array(mfi);
 
-        Box gbx = mfi.tilebox(); gbx.grow(1);
+        Box gbx = mfi.tilebox(); gbx.grow(ngf_cc);
 
         if (step == 0) {
             ParallelFor(gbx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
@@ -128,7 +136,7 @@ void erf_fast_rhs_N (int step, int nrk,
         } // step = 0
 
         Box gtbz = mfi.nodaltilebox(2);
-        gtbz.grow(IntVect(1,1,0));
+        gtbz.grow(ngf_w);
         ParallelFor(gtbz, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept {
             old_drho_w(i,j,k) = prev_zmom(i,j,k) - stage_zmom(i,j,k);
         });
@@ -153,7 +161,7 @@ void erf_fast_rhs_N (int step, int nrk,
     for ( MFIter mfi(S_stage_data[IntVars::cons],TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
         // We define lagged_delta_rt for our next step as the current delta_rt
-        Box gbx = mfi.tilebox(); gbx.grow(1);
+        Box gbx = mfi.tilebox(); gbx.grow(ngf_cc);
 
         const Array4<Real>& lagged_delta_rt = S_scratch[IntVars::cons].array(mfi);
         const Array4<Real>& old_drho_theta  = Delta_rho_theta.array(mfi);
@@ -172,8 +180,12 @@ void erf_fast_rhs_N (int step, int nrk,
 #endif
     for ( MFIter mfi(S_stage_data[IntVars::cons],TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
-        Box tbx = mfi.nodaltilebox(0);
-        Box tby = mfi.nodaltilebox(1);
+        Box tbx = mfi.grownnodaltilebox(0,ngf);
+        Box tby = mfi.grownnodaltilebox(1,ngf);
+
+        // The averaged momenta are only accumulated on the faces owned by this tile
+        Box tbx_own = mfi.nodaltilebox(0);
+        Box tby_own = mfi.nodaltilebox(1);
 
         const Array4<const Real> & stage_xmom = S_stage_data[IntVars::xmom].const_array(mfi);
         const Array4<const Real> & stage_ymom = S_stage_data[IntVars::ymom].const_array(mfi);
@@ -225,7 +237,9 @@ void erf_fast_rhs_N (int step, int nrk,
             Real new_drho_u = prev_xmom(i,j,k) - stage_xmom(i,j,k)
                 + dtau * fast_rhs_rho_u + dtau * slow_rhs_rho_u(i,j,k);
 
-            avg_xmom(i,j,k) += facinv*new_drho_u;
+            if (tbx_own.contains(IntVect(i,j,k))) {
+                avg_xmom(i,j,k) += facinv*new_drho_u;
+            }
 
             temp_cur_xmom_arr(i,j,k) = stage_xmom(i,j,k) + new_drho_u;
         },
@@ -248,7 +262,9 @@ void erf_fast_rhs_N (int step, int nrk,
             Real new_drho_v = prev_ymom(i,j,k) - stage_ymom(i,j,k)
                  + dtau * fast_rhs_rho_v + dtau * slow_rhs_rho_v(i,j,k);
 
-            avg_ymom(i,j,k) += facinv*new_drho_v;
+            if (tby_own.contains(IntVect(i,j,k))) {
+                avg_ymom(i,j,k) += facinv*new_drho_v;
+            }
 
             temp_cur_ymom_arr(i,j,k) = stage_ymom(i,j,k) + new_drho_v;
         });
@@ -262,9 +278,12 @@ void erf_fast_rhs_N (int step, int nrk,
     std::array<FArrayBox,AMREX_SPACEDIM> flux;
     for ( MFIter mfi(S_stage_data[IntVars::cons],TileNoZ()); mfi.isValid(); ++mfi)
     {
-        Box bx  = mfi.tilebox();
+        Box bx  = mfi.growntilebox(ngf);
         Box tbz = surroundingNodes(bx,2);
 
+        // The averaged momenta are only accumulated on the cells owned by this tile
+        Box bx_own = mfi.tilebox();
+
         Box vbx = mfi.validbox();
         const auto& vbx_hi = ubound(vbx);
 
@@ -495,12 +514,18 @@ void erf_fast_rhs_N (int step, int nrk,
             Real zflux_lo = beta_2 * soln_a(i,j,k  ) + beta_1 * old_drho_w(i,j,k  );
             Real zflux_hi = beta_2 * soln_a(i,j,k+1) + beta_1 * old_drho_w(i,j,k+1);
 
-            avg_zmom(i,j,k)      += facinv*zflux_lo / (mf_m(i,j,0) * mf_m(i,j,0));
+            bool owned = bx_own.contains(IntVect(i,j,k));
+
+            if (owned) {
+                avg_zmom(i,j,k)  += facinv*zflux_lo / (mf_m(i,j,0) * mf_m(i,j,0));
+            }
             (flx_arr[2])(i,j,k,0) =        zflux_lo / (mf_m(i,j,0) * mf_m(i,j,0));
             (flx_arr[2])(i,j,k,1) = (flx_arr[2])(i,j,k,0) * 0.5 * (prim(i,j,k) + prim(i,j,k-1));
 
             if (k == vbx_hi.z) {
-                avg_zmom(i,j,k+1)      += facinv * zflux_hi / (mf_m(i,j,0) * mf_m(i,j,0));
+                if (owned) {
+                    avg_zmom(i,j,k+1)  += facinv * zflux_hi / (mf_m(i,j,0) * mf_m(i,j,0));
+                }
                 (flx_arr[2])(i,j,k+1,0) =          zflux_hi / (mf_m(i,j,0) * mf_m(i,j,0));
                 (flx_arr[2])(i,j,k+1,1) = (flx_arr[2])(i,j,k+1,0) * 0.5 * (prim(i,j,k) + prim(i,j,k+1));
             }
@@ -535,7 +560,7 @@ void erf_fast_rhs_N (int step, int nrk,
 #endif
     for ( MFIter mfi(S_stage_data[IntVars::cons],TilingIfNotGPU()); mfi.isValid(); ++mfi)
     {
-        const Box& bx = mfi.tilebox();
+        const Box& bx = mfi.growntilebox(ngf);
 
         int cons_dycore{2};
         const Array4<Real>& cur_cons = S_data[IntVars::cons].array(mfi);
@@ -11,6 +11,7 @@ using namespace amrex;
  *
  * @param[in]  level level of refinement
  * @param[out] fast_coeffs  the coefficients for the tridiagonal solver computed here
+ *                          (on the valid region and any lateral ghost cells it has)
  * @param[in]  S_stage_data solution at the last stage
  * @param[in]  S_stage_prim primitive variables (i.e. conserved variables divided by density) at the last stage
  * @param[in]  pi_stage Exner function at the last stage
@@ -70,7 +71,7 @@ void make_fast_coeffs (int /*level*/,
 
     for ( MFIter mfi(S_stage_data[IntVars::cons],TileNoZ()); mfi.isValid(); ++mfi)
     {
-        Box bx  = mfi.tilebox();
+        Box bx  = mfi.growntilebox(IntVect(fast_coeffs.nGrowVect()[0],fast_coeffs.nGrowVect()[1],0));
         Box tbz = surroundingNodes(bx,2);
 
         const Array4<const Real> & stage_cons = S_stage_data[IntVars::cons].const_array(mfi);
@@ -8,6 +8,27 @@
 
 using namespace amrex;
 
+/**
+ * Which of the slow variables are advanced by erf_slow_rhs_post
+ *
+ * @param[in]  level level of resolution
+ * @param[in]  solverChoice  Container for solver parameters
+ */
+Vector<int>
+slow_vars_advanced (int level, const SolverChoice& solverChoice)
+{
+    const TurbChoice& tc = solverChoice.turbChoice[level];
+
+    Vector<int> is_valid_slow_var; is_valid_slow_var.resize(RhoQ1_comp+1,0);
+    if (tc.les_type == LESType::Deardorff)  {is_valid_slow_var[    RhoKE_comp] = 1;}
+    if (tc.use_QKE && tc.advect_QKE)        {is_valid_slow_var[   RhoQKE_comp] = 1;}
+                                             is_valid_slow_var[RhoScalar_comp] = 1;
+    if (solverChoice.moisture_type != MoistureType::None) {
+         is_valid_slow_var[RhoQ1_comp] = 1;
+    }
+    return is_valid_slow_var;
+}
+
 /**
  * Function for computing the slow RHS for the evolution equations for the scalars other than density or potential temperature
  *
@@ -115,7 +136,6 @@ void erf_slow_rhs_post (int level, int finest_level,
     if (l_moving_terrain) AMREX_ALWAYS_ASSERT(l_use_terrain);
 
     const bool l_use_mono_adv   = solverChoice.use_mono_adv;
-    const bool l_use_QKE        = tc.use_QKE && tc.advect_QKE;
     const bool l_use_deardorff  = (tc.les_type == LESType::Deardorff);
     const bool l_use_diff       = ((dc.molec_diff_type != MolecDiffType::None) ||
                                    (tc.les_type        !=       LESType::None) ||
@@ -160,13 +180,7 @@ void erf_slow_rhs_post (int level, int finest_level,
     }
 
     // Valid vars
-    Vector<int> is_valid_slow_var; is_valid_slow_var.resize(RhoQ1_comp+1,0);
-    if (l_use_deardorff) {is_valid_slow_var[    RhoKE_comp] = 1;}
-    if (l_use_QKE)       {is_valid_slow_var[   RhoQKE_comp] = 1;}
-                          is_valid_slow_var[RhoScalar_comp] = 1;
-    if (solverChoice.moisture_type != MoistureType::None) {
-         is_valid_slow_var[RhoQ1_comp] = 1;
-    }
+    Vector<int> is_valid_slow_var = slow_vars_advanced(level, solverChoice);
 
     // *****************************************************************************
     // Monotonic advection for scalars
@@ -477,12 +491,25 @@ void erf_slow_rhs_post (int level, int finest_level,
 
         {
         BL_PROFILE("rhs_post_9");
-        // This updates all the conserved variables (not just the "slow" ones)
-        int   num_comp_all = S_data[IntVars::cons].nComp();
-        ParallelFor(tbx, num_comp_all,
+        // This updates the fast variables and the slow variables advanced above; the
+        //    others are left untouched so their ghost cells remain valid
+        ParallelFor(tbx, RhoTheta_comp+1,
         [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept {
             new_cons(i,j,k,n)  = cur_cons(i,j,k,n);
         });
+        for (int ivar(RhoKE_comp); ivar<= RhoQ1_comp; ++ivar)
+        {
+            if (is_valid_slow_var[ivar])
+            {
+                start_comp = ivar;
+                num_comp   = (ivar >= RhoQ1_comp) ? nvars - RhoQ1_comp : 1;
+                ParallelFor(tbx, num_comp,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int nn) noexcept {
+                    const int n = start_comp + nn;
+                    new_cons(i,j,k,n)  = cur_cons(i,j,k,n);
+                });
+            }
+        }
         } // end profile
 
         Box xtbx = mfi.nodaltilebox(0);
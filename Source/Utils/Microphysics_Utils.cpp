@@ -0,0 +1,34 @@
+#include "Microphysics_Utils.H"
+
+#ifdef ERF_SAT_TABLE
+
+using namespace amrex;
+
+namespace SatTable {
+
+Real c0[NumFuncs][nint];
+Real c1[NumFuncs][nint];
+
+void
+init ()
+{
+    using Func = Real (*)(Real);
+    const Func analytic[NumFuncs] = {erf_esatw_analytic  , erf_esati_analytic,
+                                     erf_dtesatw_analytic, erf_dtesati_analytic};
+
+    // The fits switch formulas at nodes of the table (-80 C for the saturation
+    // pressures, and -81 C for the finite difference derivatives below it). The
+    // fits take the lower formula at the switch, so the lower end of each
+    // interval is sampled just above the node to keep the interval on one formula.
+    const Real eps = 1.e-9;
+    for (int f = 0; f < NumFuncs; ++f) {
+        for (int n = 0; n < nint; ++n) {
+            const Real tlo = tmin + n*dt;
+            c0[f][n] = analytic[f](tlo + eps);
+            c1[f][n] = analytic[f](tlo + dt) - c0[f][n];
+        }
+    }
+}
+
+}
+#endif
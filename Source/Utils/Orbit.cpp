@@ -3,11 +3,15 @@
 using namespace amrex;
 
 void
-zenith (int& calday,
+zenith (const Real& calday,
         amrex::MultiFab* clat,
         amrex::MultiFab* clon,
         real1d& coszrs,
         int& ncol,
+        int col_stride,
+        int col_ox,
+        int col_oy,
+        const Vector<int>& col_offset,
         const Real& eccen,
         const Real& mvelpp,
         const Real& lambm0,
@@ -23,16 +27,18 @@ zenith (int& calday,
     // If we have a valid pointer, go through the whole machinery
     if (clat) {
         for (MFIter mfi(*clat); mfi.isValid(); ++mfi) {
-            const auto& tbx = mfi.tilebox();
-            auto nx = tbx.length(0);
+            RadColumnMap cmap(mfi.validbox(), col_stride, col_ox, col_oy, col_offset[mfi.index()]);
+            Box sbx(IntVect(0,0,0), IntVect(cmap.nxs-1,cmap.nys-1,0));
 
             auto lat_array = clat->array(mfi);
             auto lon_array = clon->array(mfi);
 
             // NOTE: lat/lon are 2D multifabs!
-            ParallelFor(tbx, [=] AMREX_GPU_DEVICE (int i, int j, int /*k*/)
+            ParallelFor(sbx, [=] AMREX_GPU_DEVICE (int is, int js, int /*k*/)
             {
-                auto icol = j*nx+i+1;
+                int i = cmap.sample_i(is);
+                int j = cmap.sample_j(js);
+                auto icol = cmap.icol(is,js);
                 coszrs(icol) = shr_orb_cosz(calday, lat_array(i,j,0), lon_array(i,j,0), delta, uniform_angle);
             });
        }
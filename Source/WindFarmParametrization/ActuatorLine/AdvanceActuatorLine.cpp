@@ -0,0 +1,340 @@
+#include <ActuatorLine.H>
+#include <IndexDefines.H>
+#include <ERF_Constants.H>
+#include <Interpolation_1D.H>
+#include <AMReX_ParmParse.H>
+
+using namespace amrex;
+
+namespace {
+
+/**
+ * Radius, azimuth and share of the rotor load of the element e of the blade b;
+ * the load of an element is proportional to the area it sweeps
+ */
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+void blade_element (int b, int e, int num_blades, int num_elements,
+                    Real rotor_rad, Real azimuth,
+                    Real& r, Real& psi, Real& w)
+{
+    r   = (e + 0.5) * rotor_rad / num_elements;
+    psi = azimuth + 2.0 * PI * b / num_blades;
+    w   = (2.0*e + 1.0) / (Real(num_elements) * Real(num_elements) * num_blades);
+}
+
+}
+
+ActuatorLine::ActuatorLine ()
+{
+    ParmParse pp("erf");
+    pp.query("windfarm_num_blades", m_num_blades);
+    pp.query("windfarm_blade_elements", m_num_elements);
+    pp.query("windfarm_tip_speed_ratio", m_tip_speed_ratio);
+    pp.query("windfarm_projection_width", m_eps);
+    AMREX_ALWAYS_ASSERT(m_num_blades >= 1 && m_num_elements >= 1);
+    AMREX_ALWAYS_ASSERT(m_tip_speed_ratio > 0.0);
+}
+
+Real
+ActuatorLine::projection_width (const Geometry& geom) const
+{
+    if (m_eps > 0.0) return m_eps;
+    const auto dx = geom.CellSizeArray();
+    return 2.0 * amrex::max(dx[0], amrex::max(dx[1], dx[2]));
+}
+
+void
+ActuatorLine::set_turb_index (const Geometry& geom)
+{
+    // The kernel is cut off at three widths from the rotor
+    Real eps = projection_width(geom);
+    build_turb_index(geom, m_rotor_rad + 3.0*eps, 3.0*eps);
+}
+
+ActuatorLine::RotorState&
+ActuatorLine::get_rotor_state (const Geometry& geom)
+{
+    for (auto& rs : m_rotors) {
+        if (rs.domain == geom.Domain()) { return rs; }
+    }
+    m_rotors.emplace_back();
+    m_rotors.back().domain = geom.Domain();
+    return m_rotors.back();
+}
+
+void
+ActuatorLine::advance (const Geometry& geom,
+                       const Real& dt_advance,
+                       MultiFab& cons_in,
+                       MultiFab& U_old,
+                       MultiFab& V_old,
+                       MultiFab& W_old,
+                       const MultiFab& mf_Nturb)
+{
+    AMREX_ALWAYS_ASSERT(mf_Nturb.nComp() > 0);
+
+    sample_rotors(geom, cons_in, U_old, V_old, W_old);
+
+    WindFarmSources& sources = get_sources(geom);
+    source_terms_cellcentered(geom, cons_in, sources);
+    update(dt_advance, cons_in, U_old, V_old, W_old, sources);
+
+    // Turn the rotors of this level by its own time step
+    RotorState& rs = get_rotor_state(geom);
+    for (int it = 0; it < rs.azimuth.size(); ++it) {
+        rs.azimuth[it] = std::fmod(rs.azimuth[it] + rs.omega[it]*dt_advance, 2.0*PI);
+    }
+}
+
+void
+ActuatorLine::sample_rotors (const Geometry& geom,
+                             const MultiFab& cons_in,
+                             const MultiFab& U_old,
+                             const MultiFab& /*V_old*/,
+                             const MultiFab& /*W_old*/)
+{
+    get_turb_spec(rotor_rad, hub_height, thrust_coeff_standing,
+                  wind_speed, thrust_coeff, power);
+
+    RotorState& rs = get_rotor_state(geom);
+
+    const int nturbs = static_cast<int>(m_xloc.size());
+    if (static_cast<int>(rs.azimuth.size()) != nturbs) {
+        rs.azimuth.assign(nturbs, 0.0);
+        rs.omega.assign(nturbs, 0.0);
+        rs.rotor_vel.resize(nturbs);
+        rs.rotor_rho.resize(nturbs);
+        rs.thrust_rho.resize(nturbs);
+        rs.torque_rho.resize(nturbs);
+        rs.thrust.resize(nturbs);
+        rs.rotor_power.resize(nturbs);
+        rs.d_azimuth.resize(nturbs);
+        rs.d_thrust_rho.resize(nturbs);
+        rs.d_torque_rho.resize(nturbs);
+    }
+    Gpu::copyAsync(Gpu::hostToDevice, rs.azimuth.begin(), rs.azimuth.end(), rs.d_azimuth.begin());
+
+    auto dx  = geom.CellSizeArray();
+    auto plo = geom.ProbLoArray();
+
+    const int nb = m_num_blades;
+    const int ne = m_num_elements;
+    const int nelem = nturbs*nb*ne;
+    const Real R = rotor_rad;
+    const Real d_hub_height = hub_height;
+    const Real* azimuth = rs.d_azimuth.data();
+
+    const auto tidx = get_turb_index(geom).view();
+
+    // Positions and weights of the elements of all the rotors, one thread per element
+    rs.d_elem_pos.resize(3*nelem);
+    Real* elem_pos = rs.d_elem_pos.data();
+    ParallelFor(nelem, [=] AMREX_GPU_DEVICE (int n) noexcept
+    {
+        const int it = n / (nb*ne);
+        const int b  = (n / ne) % nb;
+        const int e  = n % ne;
+
+        Real r, psi, w;
+        blade_element(b, e, nb, ne, R, azimuth[it], r, psi, w);
+
+        elem_pos[3*n  ] = tidx.yloc[it] + r*std::cos(psi);
+        elem_pos[3*n+1] = d_hub_height  + r*std::sin(psi);
+        elem_pos[3*n+2] = w;
+    });
+
+    // Sums over the elements of the weights, normal velocity and density, per turbine
+    Gpu::DeviceVector<Real> d_sums(3*nturbs, 0.0);
+    Real* sums = d_sums.data();
+
+    for (MFIter mfi(cons_in); mfi.isValid(); ++mfi) {
+        const Box& vbx = mfi.validbox();
+        const auto lo = lbound(vbx);
+        const auto hi = ubound(vbx);
+        auto cons_array = cons_in.const_array(mfi);
+        auto u_vel      = U_old.const_array(mfi);
+
+        // Each element is sampled by the box that holds it
+        ParallelFor(nelem, [=] AMREX_GPU_DEVICE (int n) noexcept
+        {
+            const int it = n / (nb*ne);
+
+            int i = static_cast<int>(std::floor((tidx.xloc[it] - plo[0]) / dx[0]));
+            int j = static_cast<int>(std::floor((elem_pos[3*n  ] - plo[1]) / dx[1]));
+            int k = static_cast<int>(std::floor((elem_pos[3*n+1] - plo[2]) / dx[2]));
+            if (i < lo.x || i > hi.x || j < lo.y || j > hi.y || k < lo.z || k > hi.z) return;
+
+            const Real w = elem_pos[3*n+2];
+            Real u = 0.5*(u_vel(i,j,k) + u_vel(i+1,j,k));
+            Gpu::Atomic::AddNoRet(&sums[3*it  ], w);
+            Gpu::Atomic::AddNoRet(&sums[3*it+1], w*u);
+            Gpu::Atomic::AddNoRet(&sums[3*it+2], w*cons_array(i,j,k,Rho_comp));
+        });
+    }
+
+    Vector<Real> h_sums(3*nturbs);
+    Gpu::copy(Gpu::deviceToHost, d_sums.begin(), d_sums.end(), h_sums.begin());
+    ParallelDescriptor::ReduceRealSum(h_sums.data(), static_cast<int>(h_sums.size()));
+
+    // Loads of the rotors from momentum theory and the specification table
+    const int n_spec_table = wind_speed.size();
+    for (int it = 0; it < nturbs; ++it) {
+        Real wsum = h_sums[3*it];
+        Real U_d  = (wsum > 0.0) ? h_sums[3*it+1]/wsum : 0.0;
+        Real rho  = (wsum > 0.0) ? h_sums[3*it+2]/wsum : 1.0;
+
+        // Free-stream speed from the induction, U_d = (1-a) U_inf with C_T = 4a(1-a)
+        Real U_inf = std::abs(U_d);
+        Real C_T = thrust_coeff_standing;
+        Real P   = 0.0;
+        for (int iter = 0; iter < 5; ++iter) {
+            bool operating = (n_spec_table > 0) &&
+                             (U_inf >= wind_speed[0]) && (U_inf <= wind_speed[n_spec_table-1]);
+            C_T = (operating) ? interpolate_1d(wind_speed.data(), thrust_coeff.data(), U_inf, n_spec_table)
+                              : thrust_coeff_standing;
+            P   = (operating) ? 1000.0*interpolate_1d(wind_speed.data(), power.data(), U_inf, n_spec_table)
+                              : 0.0;
+            Real a = 0.5*(1.0 - std::sqrt(1.0 - amrex::min(C_T, Real(1.0))));
+            U_inf = std::abs(U_d) / (1.0 - a);
+        }
+
+        Real omega = m_tip_speed_ratio * U_inf / R;
+
+        rs.rotor_vel[it]   = U_d;
+        rs.rotor_rho[it]   = rho;
+        rs.thrust_rho[it]  = 0.5 * C_T * PI*R*R * U_inf*U_inf * ((U_d < 0.0) ? -1.0 : 1.0);
+        rs.torque_rho[it]  = (omega > 0.0) ? P / (rho*omega) : 0.0;
+        rs.thrust[it]      = rho * rs.thrust_rho[it];
+        rs.rotor_power[it] = P;
+        rs.omega[it]       = omega;
+    }
+
+    Gpu::copyAsync(Gpu::hostToDevice, rs.thrust_rho.begin(), rs.thrust_rho.end(), rs.d_thrust_rho.begin());
+    Gpu::copyAsync(Gpu::hostToDevice, rs.torque_rho.begin(), rs.torque_rho.end(), rs.d_torque_rho.begin());
+
+    // Forces per unit density of the elements, before the projection
+    rs.d_elem_force.resize(3*nelem);
+    Real* elem_force = rs.d_elem_force.data();
+    const Real* thrust_rho = rs.d_thrust_rho.data();
+    const Real* torque_rho = rs.d_torque_rho.data();
+    ParallelFor(nelem, [=] AMREX_GPU_DEVICE (int n) noexcept
+    {
+        const int it = n / (nb*ne);
+        const int b  = (n / ne) % nb;
+        const int e  = n % ne;
+
+        Real r, psi, w;
+        blade_element(b, e, nb, ne, R, azimuth[it], r, psi, w);
+
+        // Thrust against the flow; the reaction to the torque
+        // turns the flow against the rotor
+        Real f_n = w * thrust_rho[it];
+        Real f_t = w * torque_rho[it] / r;
+        elem_force[3*n  ] = -f_n;
+        elem_force[3*n+1] =  f_t * std::sin(psi);
+        elem_force[3*n+2] = -f_t * std::cos(psi);
+    });
+    Gpu::streamSynchronize();
+}
+
+void
+ActuatorLine::update (const Real& dt_advance,
+                      MultiFab& cons_in,
+                      MultiFab& U_old, MultiFab& V_old, MultiFab& W_old,
+                      WindFarmSources& sources)
+{
+    // There is no TKE source
+    sources.update(dt_advance, cons_in, U_old, V_old, -1, &W_old);
+}
+
+void
+ActuatorLine::source_terms_cellcentered (const Geometry& geom,
+                                         const MultiFab& cons_in,
+                                         WindFarmSources& sources)
+{
+    auto dx  = geom.CellSizeArray();
+    auto plo = geom.ProbLoArray();
+
+    const int nb = m_num_blades;
+    const int ne = m_num_elements;
+    const Real R = rotor_rad;
+    const Real d_hub_height = hub_height;
+    const Real eps = projection_width(geom);
+    const Real cutoff = 3.0*eps;
+    const Real eta_0  = 1.0 / (eps*eps*eps*std::pow(PI, 1.5));
+
+    // The turbines within the cutoff of the column of a cell
+    const auto tidx = get_turb_index(geom).view();
+
+    // The sources are only kept within the cutoff of the rotors
+    if (!sources.is_defined_on(cons_in)) {
+        iMultiFab mask(cons_in.boxArray(), cons_in.DistributionMap(), 1, 1);
+        for ( MFIter mfi(mask,TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+            const Box& gbx  = mfi.growntilebox(1);
+            auto mask_array = mask.array(mfi);
+            ParallelFor(gbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+                Real x = plo[0] + (i+0.5) * dx[0];
+                Real y = plo[1] + (j+0.5) * dx[1];
+                Real z = plo[2] + (k+0.5) * dx[2];
+                int in_footprint = 0;
+                for (int n = tidx.begin(i,j); n < tidx.end(i,j); n++) {
+                    int it = tidx.turb[n];
+                    Real dr = std::sqrt((y-tidx.yloc[it])*(y-tidx.yloc[it]) + (z-d_hub_height)*(z-d_hub_height));
+                    if (std::abs(x - tidx.xloc[it]) < cutoff && dr < R + cutoff) { in_footprint = 1; }
+                }
+                mask_array(i,j,k) = in_footprint;
+            });
+        }
+        sources.define(mask, 4); // dudt, dvdt, dTKEdt (unused), dwdt
+    }
+
+    const RotorState& rs    = get_rotor_state(geom);
+    const Real* elem_pos    = rs.d_elem_pos.data();
+    const Real* elem_force  = rs.d_elem_force.data();
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for ( MFIter mfi(cons_in); mfi.isValid(); ++mfi) {
+
+        const int ncells = sources.numCells(mfi);
+        if (ncells == 0) continue;
+
+        const IntVect* cells = sources.cells(mfi);
+        Real* al_src         = sources.values(mfi);
+
+        // Gaussian projection of the forces of the blade elements of the turbines
+        // listed for the column of the cell
+        ParallelFor(ncells, [=] AMREX_GPU_DEVICE(int n) noexcept {
+            int i = cells[n][0];
+            int j = cells[n][1];
+            int k = cells[n][2];
+
+            Real x = plo[0] + (i+0.5) * dx[0];
+            Real y = plo[1] + (j+0.5) * dx[1];
+            Real z = plo[2] + (k+0.5) * dx[2];
+
+            Real fx = 0.0, fy = 0.0, fz = 0.0;
+            for (int m = tidx.begin(i,j); m < tidx.end(i,j); m++) {
+                int it = tidx.turb[m];
+                Real ddx = x - tidx.xloc[it];
+                for (int el = it*nb*ne; el < (it+1)*nb*ne; ++el) {
+                    Real ddy = y - elem_pos[3*el  ];
+                    Real ddz = z - elem_pos[3*el+1];
+                    Real d2  = ddx*ddx + ddy*ddy + ddz*ddz;
+                    if (d2 > cutoff*cutoff) continue;
+                    Real eta = eta_0 * std::exp(-d2/(eps*eps));
+
+                    fx += elem_force[3*el  ] * eta;
+                    fy += elem_force[3*el+1] * eta;
+                    fz += elem_force[3*el+2] * eta;
+                }
+            }
+
+            al_src[         n] = fx;
+            al_src[  ncells+n] = fy;
+            al_src[2*ncells+n] = 0.0;
+            al_src[3*ncells+n] = fz;
+        });
+    }
+}
@@ -3,6 +3,10 @@
  */
 
 #include <WindFarm.H>
+#include <IndexDefines.H>
+#include <ERF_Constants.H>
+#include <Interpolation_1D.H>
+#include <AMReX_Utility.H>
 
 using namespace amrex;
 
@@ -195,12 +199,18 @@ WindFarm::read_windfarm_spec_table(const std::string windfarm_spec_table)
 
 }
 
+/**
+ * Count the turbine hubs in each cell; the cells only test the turbines that the
+ * turbine index lists for their column.
+ *
+ * @param[in]  geom     geometry of the level
+ * @param[out] mf_Nturb number of turbines in each cell
+ */
 void
 WindFarm::fill_Nturb_multifab(const Geometry& geom,
                               MultiFab& mf_Nturb)
 {
-    Real* xloc_ptr     = xloc.data();
-    Real* yloc_ptr     = yloc.data();
+    const auto tidx = m_windfarm_model[0]->get_turb_index(geom).view();
 
     mf_Nturb.setVal(0);
 
@@ -208,7 +218,6 @@ WindFarm::fill_Nturb_multifab(const Geometry& geom,
     int j_lo = geom.Domain().smallEnd(1); int j_hi = geom.Domain().bigEnd(1);
     auto dx = geom.CellSizeArray();
     auto ProbLoArr = geom.ProbLoArray();
-    int num_turb = xloc.size();
 
      // Initialize wind farm
     for ( MFIter mfi(mf_Nturb,TilingIfNotGPU()); mfi.isValid(); ++mfi) {
@@ -223,9 +232,10 @@ WindFarm::fill_Nturb_multifab(const Geometry& geom,
             Real y1 = ProbLoArr[1] + lj*dx[1];
             Real y2 = ProbLoArr[1] + (lj+1)*dx[1];
 
-            for(int it=0; it<num_turb; it++){
-                if( xloc_ptr[it]+1e-12 > x1 and xloc_ptr[it]+1e-12 < x2 and
-                    yloc_ptr[it]+1e-12 > y1 and yloc_ptr[it]+1e-12 < y2){
+            for (int n = tidx.begin(li,lj); n < tidx.end(li,lj); n++) {
+                int it = tidx.turb[n];
+                if( tidx.xloc[it]+1e-12 > x1 and tidx.xloc[it]+1e-12 < x2 and
+                    tidx.yloc[it]+1e-12 > y1 and tidx.yloc[it]+1e-12 < y2){
                        Nturb_array(i,j,k,0) = Nturb_array(i,j,k,0) + 1;
                 }
             }
@@ -289,3 +299,129 @@ WindFarm::write_actuator_disks_vtk()
 }
 
 
+
+
+/**
+ * Rotor-averaged velocity, thrust and power of each turbine. The models that
+ * resolve the rotors report their own loads; for the others the horizontal speed
+ * and the density are averaged over the rotor in the column of the hub, weighted
+ * by the rotor area in each level, and the loads follow from the specification
+ * table. All the turbines are sampled in one pass and reduced in one collective.
+ *
+ * @param[in]  geom        geometry of the level
+ * @param[in]  cons_in     cell-centered state
+ * @param[in]  U           x-velocity
+ * @param[in]  V           y-velocity
+ * @param[out] rotor_vel   rotor-averaged velocity (m/s)
+ * @param[out] thrust      thrust (N)
+ * @param[out] rotor_power power (W)
+ */
+void
+WindFarm::compute_turb_loads (const Geometry& geom,
+                              const MultiFab& cons_in,
+                              const MultiFab& U,
+                              const MultiFab& V,
+                              Vector<Real>& rotor_vel,
+                              Vector<Real>& thrust,
+                              Vector<Real>& rotor_power)
+{
+    if (m_windfarm_model[0]->get_turb_loads(geom, rotor_vel, thrust, rotor_power)) return;
+
+    const int nturbs = static_cast<int>(xloc.size());
+
+    const auto tidx = m_windfarm_model[0]->get_turb_index(geom).view();
+    const auto rw   = m_windfarm_model[0]->get_rotor_weights(geom).view();
+
+    auto dx  = geom.CellSizeArray();
+    auto plo = geom.ProbLoArray();
+
+    // Sums over the rotor of the weights, speed and density, per turbine
+    Gpu::DeviceVector<Real> d_sums(3*nturbs, 0.0);
+    Real* sums = d_sums.data();
+
+    for ( MFIter mfi(cons_in,TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        const Box& bx   = mfi.tilebox();
+        auto cons_array = cons_in.const_array(mfi);
+        auto u_vel      = U.const_array(mfi);
+        auto v_vel      = V.const_array(mfi);
+        ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+            Real area = rw.area(k);
+            if (area <= 0.0) return;
+            for (int n = tidx.begin(i,j); n < tidx.end(i,j); n++) {
+                int it = tidx.turb[n];
+                int ih = static_cast<int>(std::floor((tidx.xloc[it] + 1e-12 - plo[0]) / dx[0]));
+                int jh = static_cast<int>(std::floor((tidx.yloc[it] + 1e-12 - plo[1]) / dx[1]));
+                if (i != ih || j != jh) continue;
+
+                Real u = 0.5*(u_vel(i,j,k) + u_vel(i+1,j,k));
+                Real v = 0.5*(v_vel(i,j,k) + v_vel(i,j+1,k));
+                Gpu::Atomic::AddNoRet(&sums[3*it  ], area);
+                Gpu::Atomic::AddNoRet(&sums[3*it+1], area*std::sqrt(u*u + v*v));
+                Gpu::Atomic::AddNoRet(&sums[3*it+2], area*cons_array(i,j,k,Rho_comp));
+            }
+        });
+    }
+
+    Vector<Real> h_sums(3*nturbs);
+    Gpu::copy(Gpu::deviceToHost, d_sums.begin(), d_sums.end(), h_sums.begin());
+    ParallelDescriptor::ReduceRealSum(h_sums.data(), static_cast<int>(h_sums.size()));
+
+    rotor_vel.resize(nturbs);
+    thrust.resize(nturbs);
+    rotor_power.resize(nturbs);
+
+    const int n_spec_table = wind_speed.size();
+    for (int it = 0; it < nturbs; ++it) {
+        Real wsum = h_sums[3*it];
+        Real vel  = (wsum > 0.0) ? h_sums[3*it+1]/wsum : 0.0;
+        Real rho  = (wsum > 0.0) ? h_sums[3*it+2]/wsum : 0.0;
+
+        bool operating = (n_spec_table > 0) &&
+                         (vel >= wind_speed[0]) && (vel <= wind_speed[n_spec_table-1]);
+        Real C_T = (operating) ? interpolate_1d(wind_speed.data(), thrust_coeff.data(), vel, n_spec_table)
+                               : thrust_coeff_standing;
+
+        rotor_vel[it]   = vel;
+        thrust[it]      = 0.5 * rho * C_T * PI*rotor_rad*rotor_rad * vel*vel;
+        rotor_power[it] = (operating) ? 1000.0*interpolate_1d(wind_speed.data(), power.data(), vel, n_spec_table)
+                                      : 0.0;
+    }
+}
+
+
+/**
+ * Append the rotor-averaged velocity, thrust and power of each turbine to a
+ * comma-separated time series, one line per turbine
+ *
+ * @param[in] geom     geometry of the level
+ * @param[in] time     current time
+ * @param[in] cons_in  cell-centered state
+ * @param[in] U        x-velocity
+ * @param[in] V        y-velocity
+ * @param[in] filename name of the time series file
+ */
+void
+WindFarm::write_turbine_time_series (const Geometry& geom,
+                                     const Real& time,
+                                     const MultiFab& cons_in,
+                                     const MultiFab& U,
+                                     const MultiFab& V,
+                                     const std::string& filename)
+{
+    Vector<Real> rotor_vel, thrust, rotor_power;
+    compute_turb_loads(geom, cons_in, U, V, rotor_vel, thrust, rotor_power);
+
+    if (ParallelDescriptor::IOProcessor()){
+        bool new_file = !FileExists(filename);
+        FILE* file_time_series;
+        file_time_series = fopen(filename.c_str(),"a");
+        if (new_file) {
+            fprintf(file_time_series, "%s\n","time,turbine,x,y,rotor_velocity,thrust,power");
+        }
+        for(int it=0; it<xloc.size(); it++){
+            fprintf(file_time_series, "%0.15g,%d,%0.15g,%0.15g,%0.15g,%0.15g,%0.15g\n",
+                    time, it, xloc[it], yloc[it], rotor_vel[it], thrust[it], rotor_power[it]);
+        }
+        fclose(file_time_series);
+    }
+}
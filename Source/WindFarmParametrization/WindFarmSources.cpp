@@ -0,0 +1,123 @@
+/**
+ * \file WindFarmSources.cpp
+ */
+
+#include <WindFarmSources.H>
+#include <AMReX_Scan.H>
+
+using namespace amrex;
+
+void
+WindFarmSources::define (const iMultiFab& mask, int ncomp)
+{
+    AMREX_ALWAYS_ASSERT(mask.nGrow() >= 1);
+
+    m_ncomp = ncomp;
+    m_ba    = mask.boxArray();
+    m_dm    = mask.DistributionMap();
+    m_cells.define(m_ba, m_dm);
+    m_values.define(m_ba, m_dm);
+
+    for (MFIter mfi(mask); mfi.isValid(); ++mfi) {
+        const Box gbx = amrex::grow(mfi.validbox(), IntVect(1,1,1));
+        const auto mask_arr = mask.const_array(mfi);
+
+        const auto lo  = amrex::lbound(gbx);
+        const auto len = amrex::length(gbx);
+        const int npts = static_cast<int>(gbx.numPts());
+
+        // Compact the footprint cells of the box into the list
+        Gpu::DeviceVector<IntVect> all_cells(npts);
+        IntVect* all_ptr = all_cells.data();
+        int ncells = Scan::PrefixSum<int>(npts,
+            [=] AMREX_GPU_DEVICE (int n) -> int
+            {
+                int i = lo.x + n % len.x;
+                int j = lo.y + (n / len.x) % len.y;
+                int k = lo.z + n / (len.x*len.y);
+                return (mask_arr(i,j,k) != 0) ? 1 : 0;
+            },
+            [=] AMREX_GPU_DEVICE (int n, int const& s)
+            {
+                int i = lo.x + n % len.x;
+                int j = lo.y + (n / len.x) % len.y;
+                int k = lo.z + n / (len.x*len.y);
+                if (mask_arr(i,j,k) != 0) { all_ptr[s] = IntVect(i,j,k); }
+            },
+            Scan::Type::exclusive, Scan::retSum);
+
+        auto& cells = m_cells[mfi];
+        cells.resize(ncells);
+        Gpu::copyAsync(Gpu::deviceToDevice, all_cells.begin(), all_cells.begin()+ncells, cells.begin());
+
+        m_values[mfi].resize(ncells*ncomp);
+        Gpu::streamSynchronize();
+    }
+
+    m_defined = true;
+}
+
+void
+WindFarmSources::update (const Real& dt_advance,
+                         MultiFab& cons,
+                         MultiFab& U,
+                         MultiFab& V,
+                         int qke_comp,
+                         MultiFab* W)
+{
+    const bool do_qke = (qke_comp >= 0 && m_ncomp > 2);
+    const bool do_w   = (W != nullptr && m_ncomp > 3);
+
+    // Each box only adds to its own data, so the boxes can go to different
+    // threads; the neighboring cells of a box add to the same faces, hence the
+    // atomics
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(cons); mfi.isValid(); ++mfi) {
+        const int ncells = numCells(mfi);
+        if (ncells == 0) continue;
+
+        const auto lo = amrex::lbound(mfi.validbox());
+        const auto hi = amrex::ubound(mfi.validbox());
+
+        const IntVect* cell_ptr = cells(mfi);
+        const Real*    src      = values(mfi);
+
+        auto cons_array = cons.array(mfi);
+        auto u_vel      = U.array(mfi);
+        auto v_vel      = V.array(mfi);
+        auto w_vel      = (do_w) ? W->array(mfi) : Array4<Real>{};
+
+        ParallelFor(ncells, [=] AMREX_GPU_DEVICE (int n) noexcept
+        {
+            const int i = cell_ptr[n][0];
+            const int j = cell_ptr[n][1];
+            const int k = cell_ptr[n][2];
+
+            const bool i_in = (i >= lo.x && i <= hi.x);
+            const bool j_in = (j >= lo.y && j <= hi.y);
+            const bool k_in = (k >= lo.z && k <= hi.z);
+
+            // Each cell gives half of its source to the two faces around it
+            if (j_in && k_in) {
+                Real du = 0.5*src[n]*dt_advance;
+                if (i   >= lo.x && i   <= hi.x+1) { Gpu::Atomic::AddNoRet(&u_vel(i  ,j,k), du); }
+                if (i+1 >= lo.x && i+1 <= hi.x+1) { Gpu::Atomic::AddNoRet(&u_vel(i+1,j,k), du); }
+            }
+            if (i_in && k_in) {
+                Real dv = 0.5*src[ncells+n]*dt_advance;
+                if (j   >= lo.y && j   <= hi.y+1) { Gpu::Atomic::AddNoRet(&v_vel(i,j  ,k), dv); }
+                if (j+1 >= lo.y && j+1 <= hi.y+1) { Gpu::Atomic::AddNoRet(&v_vel(i,j+1,k), dv); }
+            }
+            if (do_qke && i_in && j_in && k_in) {
+                cons_array(i,j,k,qke_comp) += src[2*ncells+n]*dt_advance;
+            }
+            if (do_w && i_in && j_in) {
+                Real dw = 0.5*src[3*ncells+n]*dt_advance;
+                if (k   >= lo.z && k   <= hi.z+1) { Gpu::Atomic::AddNoRet(&w_vel(i,j,k  ), dw); }
+                if (k+1 >= lo.z && k+1 <= hi.z+1) { Gpu::Atomic::AddNoRet(&w_vel(i,j,k+1), dw); }
+            }
+        });
+    }
+}
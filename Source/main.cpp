@@ -7,6 +7,8 @@
 //#include "IO.H"
 #include "ERF.H"
 
+#include "Microphysics_Utils.H"
+
 #ifdef ERF_USE_MULTIBLOCK
 #include <MultiBlockContainer.H>
 #endif
@@ -117,6 +119,11 @@ int main (int argc, char* argv[])
     // timer for profiling
     BL_PROFILE_VAR("main()", pmain);
 
+#ifdef ERF_SAT_TABLE
+    // Tabulate the saturation vapor pressures
+    SatTable::init();
+#endif
+
     // wallclock time
     const Real strt_total = amrex::second();
 
@@ -73,6 +73,57 @@ function(add_test_0 TEST_NAME TEST_EXE PLTFILE)
     )
 endfunction(add_test_0)
 
+# Option test -- run the same input with and without OPTION and compare the two
+# plotfiles with each other rather than with a gold file. If the test directory
+# holds compare_logs.sh, it is also run on the data logs of the two runs and the
+# run log of the run with OPTION. An optional fifth argument replaces the fcompare
+# tolerances.
+function(add_test_c TEST_NAME TEST_EXE PLTFILE OPTION)
+    setup_test()
+
+    set(TEST_EXE ${CMAKE_BINARY_DIR}/Exec/${TEST_EXE})
+    if(ARGC GREATER 4)
+        set(FCOMPARE_TOLERANCE "${ARGV4}")
+    else()
+        set(FCOMPARE_TOLERANCE "-r 1e-6 --abs_tol 1.0e-8")
+    endif()
+    set(FCOMPARE_FLAGS "--abort_if_not_all_found -a ${FCOMPARE_TOLERANCE}")
+    set(RUN_REF "${MPI_COMMANDS} ${TEST_EXE} ${CURRENT_TEST_BINARY_DIR}/${TEST_NAME}.i ${RUNTIME_OPTIONS} erf.plot_file_1=ref_plt erf.data_log=ref_log > ${TEST_NAME}_ref.log")
+    set(RUN_OPT "${MPI_COMMANDS} ${TEST_EXE} ${CURRENT_TEST_BINARY_DIR}/${TEST_NAME}.i ${RUNTIME_OPTIONS} ${OPTION} erf.plot_file_1=plt erf.data_log=opt_log > ${TEST_NAME}.log")
+    set(CMP_PLT "${MPI_FCOMP_COMMANDS} ${FCOMPARE_EXE} ${FCOMPARE_FLAGS} ${CURRENT_TEST_BINARY_DIR}/ref_${PLTFILE} ${CURRENT_TEST_BINARY_DIR}/${PLTFILE}")
+    set(CMP_LOG "if [ -f compare_logs.sh ]; then sh compare_logs.sh ref_log opt_log 1e-4 ${TEST_NAME}.log; fi")
+    set(test_command sh -c "${RUN_REF} && ${RUN_OPT} && ${CMP_PLT} && ${CMP_LOG}")
+
+    add_test(${TEST_NAME} ${test_command})
+    set_tests_properties(${TEST_NAME}
+        PROPERTIES
+        TIMEOUT 5400
+        PROCESSORS ${NP}
+        WORKING_DIRECTORY "${CURRENT_TEST_BINARY_DIR}/"
+        LABELS "regression"
+        ATTACHED_FILES_ON_FAIL "${CURRENT_TEST_BINARY_DIR}/${TEST_NAME}.log"
+    )
+endfunction(add_test_c)
+
+# Verification test -- run the input and check its log with check_log.sh from the
+# test directory instead of comparing a plotfile with a gold file
+function(add_test_v TEST_NAME TEST_EXE)
+    setup_test()
+
+    set(TEST_EXE ${CMAKE_BINARY_DIR}/Exec/${TEST_EXE})
+    set(test_command sh -c "${MPI_COMMANDS} ${TEST_EXE} ${CURRENT_TEST_BINARY_DIR}/${TEST_NAME}.i ${RUNTIME_OPTIONS} > ${TEST_NAME}.log && sh check_log.sh ${TEST_NAME}.log")
+
+    add_test(${TEST_NAME} ${test_command})
+    set_tests_properties(${TEST_NAME}
+        PROPERTIES
+        TIMEOUT 5400
+        PROCESSORS ${NP}
+        WORKING_DIRECTORY "${CURRENT_TEST_BINARY_DIR}/"
+        LABELS "regression"
+        ATTACHED_FILES_ON_FAIL "${CURRENT_TEST_BINARY_DIR}/${TEST_NAME}.log"
+    )
+endfunction(add_test_v)
+
 #=============================================================================
 # Regression tests
 #=============================================================================
@@ -116,6 +167,18 @@ add_test_r(MoistBubble                       "RegTests/Bubble/*/erf_bubble.exe"
 
 add_test_0(Deardorff_stationary              "ABL/*/erf_abl.exe" "plt00010")
 
+add_test_c(ABL_MOST_fixed_iters              "ABL/*/erf_abl.exe" "plt00010" "erf.most.fixed_iters=3")
+add_test_c(FastHaloDepth_IsentropicVortexAdv "RegTests/IsentropicVortex/*/erf_isentropic_vortex.exe" "plt00010" "erf.fast_halo_depth=3")
+add_test_v(Kessler_RainSplitColumns          "RegTests/Bubble/*/erf_bubble.exe")
+
+if(ERF_ENABLE_RRTMGP)
+add_test_c(Radiation_ColumnStride            "RegTests/Bubble/*/erf_bubble.exe" "plt00002" "erf.radiation_column_stride=2" "-r 2e-2 --abs_tol 1.0e-5")
+endif()
+
+if(ERF_ENABLE_PARTICLES)
+add_test_v(SuperDroplets_MoistBubble         "RegTests/Bubble/*/erf_bubble.exe")
+endif()
+
 else()
 #add_test_r(Bubble_DensityCurrent             "Bubble/bubble" "plt00010")
 add_test_r(CouetteFlow                       "RegTests/Couette_Poiseuille/erf_couette_poiseuille" "plt00050")
@@ -156,6 +219,18 @@ add_test_r(MoistBubble                       "RegTests/Bubble/erf_bubble" "plt00
 
 add_test_0(InitSoundingIdeal_stationary      "ABL/erf_abl" "plt00010")
 add_test_0(Deardorff_stationary              "ABL/erf_abl" "plt00010")
+
+add_test_c(ABL_MOST_fixed_iters              "ABL/erf_abl" "plt00010" "erf.most.fixed_iters=3")
+add_test_c(FastHaloDepth_IsentropicVortexAdv "RegTests/IsentropicVortex/erf_isentropic_vortex" "plt00010" "erf.fast_halo_depth=3")
+add_test_v(Kessler_RainSplitColumns          "RegTests/Bubble/erf_bubble")
+
+if(ERF_ENABLE_RRTMGP)
+add_test_c(Radiation_ColumnStride            "RegTests/Bubble/erf_bubble" "plt00002" "erf.radiation_column_stride=2" "-r 2e-2 --abs_tol 1.0e-5")
+endif()
+
+if(ERF_ENABLE_PARTICLES)
+add_test_v(SuperDroplets_MoistBubble         "RegTests/Bubble/erf_bubble")
+endif()
 endif()
 #=============================================================================
 # Performance tests
@@ -0,0 +1,121 @@
+/**
+ * Unit test of the time integrators of the particle advection (advect_position).
+ *
+ * Advances a particle for one revolution of a steady solid-body rotation, with
+ * the velocity interpolated from the faces of a mesh as in ERFPC::AdvectWithFlow.
+ * The trilinear interpolation is exact for this field, so the error at the start
+ * position is the error of the time integrator only. Fails if the order of
+ * convergence measured between successive step sizes is below that of the
+ * scheme (2 for the midpoint method, 3 for SSP-RK3) less a margin.
+ */
+#include <AMReX.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_Print.H>
+
+#include "ERFPC.H"
+
+using namespace amrex;
+
+namespace {
+
+struct TestParticle
+{
+    ParticleReal m_pos[AMREX_SPACEDIM];
+
+    ParticleReal& pos (int d) { return m_pos[d]; }
+    ParticleReal  pos (int d) const { return m_pos[d]; }
+};
+
+// Error after one revolution in nsteps steps
+Real revolution_error (const GpuArray<Array4<Real const>,AMREX_SPACEDIM>& umac,
+                       const GpuArray<Real,AMREX_SPACEDIM>& plo,
+                       const GpuArray<Real,AMREX_SPACEDIM>& dxi,
+                       const ParticleReal* pos_start, Real period, int nsteps, bool rk3)
+{
+    TestParticle p;
+    MACStencil stencil;
+    auto vel = [&] (const ParticleReal* a_pos, ParticleReal* a_v)
+    {
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) { p.pos(d) = a_pos[d]; }
+        mac_interpolate_cached(p, plo, dxi, umac, stencil, a_v);
+    };
+
+    ParticleReal pos[AMREX_SPACEDIM];
+    ParticleReal v[AMREX_SPACEDIM];
+    for (int d = 0; d < AMREX_SPACEDIM; ++d) { pos[d] = pos_start[d]; }
+
+    const Real dt = period/nsteps;
+    for (int n = 0; n < nsteps; ++n) {
+        advect_position(pos, dt, rk3, vel, v);
+    }
+
+    Real err = 0.0;
+    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+        err += (pos[d] - pos_start[d])*(pos[d] - pos_start[d]);
+    }
+    return std::sqrt(err);
+}
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+
+    int nfail = 0;
+    {
+        // Unit cube of 32^3 cells, rotating once per unit time about the vertical
+        //    axis through its center
+        const int  ncell = 32;
+        const Real dx    = 1.0/ncell;
+        const Real omega = 2.0*M_PI;
+        const Real period = 2.0*M_PI/omega;
+
+        const GpuArray<Real,AMREX_SPACEDIM> plo {AMREX_D_DECL(0.0, 0.0, 0.0)};
+        const GpuArray<Real,AMREX_SPACEDIM> dxi {AMREX_D_DECL(1.0/dx, 1.0/dx, 1.0/dx)};
+
+        const Box bx(IntVect(0), IntVect(ncell-1));
+        FArrayBox fab[AMREX_SPACEDIM];
+        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+            const Box fbx = grow(convert(bx, IntVect::TheDimensionVector(d)), 1);
+            fab[d].resize(fbx, 1);
+            auto const& u = fab[d].array();
+            For(fbx, [=] (int i, int j, int k) noexcept
+            {
+                const Real x = (i + ((d == 0) ? 0.0 : 0.5))*dx;
+                const Real y = (j + ((d == 1) ? 0.0 : 0.5))*dx;
+                u(i,j,k) = (d == 0) ? -omega*(y - 0.5) : (d == 1) ? omega*(x - 0.5) : 0.0;
+            });
+        }
+        const GpuArray<Array4<Real const>,AMREX_SPACEDIM> umac {{AMREX_D_DECL(fab[0].const_array(),
+                                                                               fab[1].const_array(),
+                                                                               fab[2].const_array())}};
+
+        const ParticleReal pos_start[AMREX_SPACEDIM] = {AMREX_D_DECL(0.75, 0.5, 0.5)};
+
+        struct Scheme { const char* name; bool rk3; Real order; };
+        const Scheme schemes[] = {{"midpoint", false, 2.0}, {"rk3", true, 3.0}};
+        const Real margin = 0.2;
+        const int  nsteps[] = {16, 32, 64};
+
+        for (const auto& s : schemes) {
+            Real err_prev = 0.0;
+            for (int ns : nsteps) {
+                const Real err = revolution_error(umac, plo, dxi, pos_start, period, ns, s.rk3);
+                Print() << s.name << ": " << ns << " steps per revolution, error " << err;
+                if (ns != nsteps[0]) {
+                    const Real order = std::log2(err_prev/err);
+                    const bool pass = (order >= s.order - margin);
+                    Print() << ", order " << order << (pass ? " PASS" : " FAIL");
+                    if (!pass) { ++nfail; }
+                }
+                Print() << std::endl;
+                err_prev = err;
+            }
+        }
+    }
+
+    amrex::Finalize();
+
+    return (nfail == 0) ? 0 : 1;
+}
@@ -0,0 +1,94 @@
+/**
+ * Unit test of the tabulated saturation vapor pressures (ERF_USE_SAT_TABLE).
+ *
+ * Compares the table lookups of erf_esatw, erf_esati, erf_dtesatw, erf_dtesati,
+ * erf_qsatw, erf_qsati, erf_dtqsatw and erf_dtqsati with the analytic fits at
+ * points inside every interval of the table, and fails if the relative error of
+ * any of them exceeds the tolerance.
+ */
+#include <AMReX.H>
+#include <AMReX_Print.H>
+
+#include "Microphysics_Utils.H"
+
+using namespace amrex;
+
+namespace {
+
+// Saturation mixing ratios and their derivatives from the analytic fits,
+//    written as in erf_qsatw & co.
+Real qsat_analytic (Real esat, Real p) { return Rd_on_Rv*esat/std::max(esat,p-esat); }
+Real dtqsat_analytic (Real dtesat, Real p) { return Rd_on_Rv*dtesat/p; }
+
+struct ErrorCheck
+{
+    const char* name;
+    Real max_err{0.0};
+    Real t_max_err{0.0};
+
+    void add (Real t, Real val, Real ref)
+    {
+        const Real err = std::abs(val - ref) / std::max(std::abs(ref), Real(1.e-30));
+        if (err > max_err) {
+            max_err   = err;
+            t_max_err = t;
+        }
+    }
+};
+
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+
+    int nfail = 0;
+    {
+        SatTable::init();
+
+        const Real tol  = 5.e-4;
+        const int  nsub = 10;
+
+        // Pressures (mbar) at which the mixing ratios are compared
+        const Real pres[3] = {1000.0, 500.0, 100.0};
+
+        ErrorCheck checks[] = {{"esatw"}, {"esati"}, {"dtesatw"}, {"dtesati"},
+                               {"qsatw"}, {"qsati"}, {"dtqsatw"}, {"dtqsati"}};
+
+        for (int n = 0; n < SatTable::nint; ++n) {
+            for (int m = 0; m < nsub; ++m) {
+                const Real t = SatTable::tmin + (n + (m+0.5)/nsub)*SatTable::dt;
+
+                const Real esatw_ref   = erf_esatw_analytic(t);
+                const Real esati_ref   = erf_esati_analytic(t);
+                const Real dtesatw_ref = erf_dtesatw_analytic(t);
+                const Real dtesati_ref = erf_dtesati_analytic(t);
+
+                checks[0].add(t, erf_esatw(t)  , esatw_ref);
+                checks[1].add(t, erf_esati(t)  , esati_ref);
+                checks[2].add(t, erf_dtesatw(t), dtesatw_ref);
+                checks[3].add(t, erf_dtesati(t), dtesati_ref);
+
+                for (Real p : pres) {
+                    Real q;
+                    erf_qsatw(t, p, q);   checks[4].add(t, q, qsat_analytic(esatw_ref, p));
+                    erf_qsati(t, p, q);   checks[5].add(t, q, qsat_analytic(esati_ref, p));
+                    erf_dtqsatw(t, p, q); checks[6].add(t, q, dtqsat_analytic(dtesatw_ref, p));
+                    erf_dtqsati(t, p, q); checks[7].add(t, q, dtqsat_analytic(dtesati_ref, p));
+                }
+            }
+        }
+
+        for (const auto& c : checks) {
+            const bool pass = (c.max_err <= tol);
+            Print() << (pass ? "PASS " : "FAIL ") << c.name
+                    << ": max relative error " << c.max_err
+                    << " at T = " << c.t_max_err << std::endl;
+            if (!pass) { ++nfail; }
+        }
+    }
+
+    amrex::Finalize();
+
+    return (nfail == 0) ? 0 : 1;
+}
@@ -0,0 +1,28 @@
+#!/bin/sh
+# Compare the averaged u*, t* and Obukhov length written to two ERF data logs, and
+# check that the fixed iterations never fell back to iterating to convergence.
+# Usage: compare_logs.sh <log_a> <log_b> <relative tolerance> <run log of log_b>
+if grep -q "iterating to convergence" "$4"; then
+    grep "iterating to convergence" "$4" | head -1
+    echo "the fixed iterations fell back to iterating to convergence"
+    exit 1
+fi
+
+paste "$1" "$2" | awk -v tol="$3" '
+NR == 1 { next }
+{
+    for (c = 2; c <= 4; c++) {
+        a = $c; b = $(c+4);
+        d = a - b; if (d < 0) d = -d;
+        s = (a < 0) ? -a : a; if (s < 1.0e-12) s = 1.0;
+        if (d > tol*s) {
+            printf("time %s column %d: %s vs %s\n", $1, c, a, b);
+            bad = 1;
+        }
+    }
+    n++;
+}
+END {
+    if (n == 0) { print "no data to compare"; exit 1 }
+    exit bad
+}'
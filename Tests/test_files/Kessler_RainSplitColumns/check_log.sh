@@ -0,0 +1,17 @@
+#!/bin/sh
+# Check that the sedimentation of the rain conserves the rain in the air plus the
+# rain on the ground when the columns are split between boxes.
+# Usage: check_log.sh <log>
+awk '
+/^Kessler: rain mass/ {
+    n++;
+    if ($4 > 0.0) rain++;
+    d = $8 - $4; if (d < 0.0) d = -d;
+    if ($4 > 0.0 && d > 1.0e-10*$4) { print "rain mass " $4 " kg became " $8 " kg"; bad++ }
+}
+END {
+    if (n == 0)    { print "no Kessler diagnostics in the log"; exit 1 }
+    if (rain == 0) { print "no rain in " n " steps"; exit 1 }
+    if (bad > 0)   { print "rain mass not conserved in " bad " of " n " steps"; exit 1 }
+    print "rain mass conserved in " rain " steps with rain of " n " steps";
+}' "$1"
@@ -0,0 +1,15 @@
+#!/bin/sh
+# Check that the super-droplets exchanged water with the vapor and coalesced.
+# Usage: check_log.sh <log>
+awk '
+/^Super-droplets: condensed/ {
+    n++;
+    if ($3 != 0.0) cond++;
+    if ($7 > 0.0) coal++;
+}
+END {
+    if (n == 0)    { print "no super-droplet diagnostics in the log"; exit 1 }
+    if (cond == 0) { print "no condensation or evaporation in " n " steps"; exit 1 }
+    if (coal == 0) { print "no coalescence in " n " steps"; exit 1 }
+    print "condensation in " cond " and coalescence in " coal " of " n " steps";
+}' "$1"